@@ -9,6 +9,16 @@ struct CellIndex {
     int y;
 };
 
+inline bool operator==(CellIndex a, CellIndex b)
+{
+    return a.x == b.x && a.y == b.y;
+}
+
+inline bool operator!=(CellIndex a, CellIndex b)
+{
+    return !(a == b);
+}
+
 struct BoardSize {
     int width;
     int height;
@@ -1,17 +1,19 @@
 #include "connect_4.h"
 #include <p6/p6.h>
 #include <chrono>
-#include <functional>
 #include <iostream>
 #include <thread>
 #include "board.h"
+#include "mnk_game.h"
+#include "tablebase.h"
 
 enum class Player {
     Red,
     Yellow,
 };
 
-using Board = BoardT<7, 6, Player>;
+template<typename GameRules>
+using BoardFor = typename GameRules::template Board<Player>;
 
 void draw_token(CellIndex index, BoardSize board_size, Player player, p6::Context& ctx, bool is_preview = false)
 {
@@ -26,11 +28,12 @@ void draw_token(CellIndex index, BoardSize board_size, Player player, p6::Contex
                p6::Radius{cell_radius(board_size)});
 }
 
-void draw_tokens(const Board& board, p6::Context& ctx)
+template<typename BoardType>
+void draw_tokens(const BoardType& board, p6::Context& ctx)
 {
     for (int x = 0; x < board.width(); ++x) {
         for (int y = 0; y < board.height(); ++y) {
-            const auto cell = board[{x, y}];
+            const auto& cell = board[{x, y}];
             if (cell.has_value()) {
                 draw_token({x, y}, board.size(), *cell, ctx);
             }
@@ -38,22 +41,13 @@ void draw_tokens(const Board& board, p6::Context& ctx)
     }
 }
 
-std::optional<int> try_to_find_lowest_empty_row_index(int column_index, const Board& board)
-{
-    for (int y = 0; y < board.height(); ++y) {
-        if (!board[{column_index, y}].has_value()) {
-            return std::make_optional(y);
-        }
-    }
-    return std::nullopt;
-}
-
 /// Returns true iff the column was not full and a token has been successfully added to the column.
-bool try_to_play_in_column(int column_index, Player player, Board& board)
+template<typename GameRules>
+bool try_to_play_in_column(int column_index, Player player, BoardFor<GameRules>& board)
 {
-    const auto row_index = try_to_find_lowest_empty_row_index(column_index, board);
-    if (row_index.has_value()) {
-        board[{column_index, *row_index}] = std::make_optional(player);
+    const auto cell = GameRules::landing_cell(board, CellIndex{column_index, 0});
+    if (cell.has_value()) {
+        board[*cell] = std::make_optional(player);
         return true;
     }
     else {
@@ -86,148 +80,22 @@ Player next_player(Player player)
     }
 }
 
-void preview_token_at(glm::vec2 pos_in_window_space, const Board& board, Player player, p6::Context& ctx)
+template<typename GameRules>
+void preview_token_at(glm::vec2 pos_in_window_space, const BoardFor<GameRules>& board, Player player, p6::Context& ctx)
 {
     const auto hovered_column = column_at(pos_in_window_space, board.size());
     if (hovered_column.has_value()) {
-        const auto row = try_to_find_lowest_empty_row_index(*hovered_column, board);
-        if (row.has_value()) {
-            draw_token({*hovered_column, *row},
-                       board.size(), player, ctx, true);
-        }
-    }
-}
-
-std::optional<Player> winner_on_line(const Board& board, std::function<std::optional<CellIndex>(int)> index_generator)
-{
-    auto prev_cell          = index_generator(0);
-    auto cell               = index_generator(1);
-    int  index              = 1;
-    int  consecutive_tokens = 1;
-    while (cell.has_value()) {
-        if (board[*prev_cell] == board[*cell] && board[*cell].has_value()) {
-            consecutive_tokens++;
-            if (consecutive_tokens == 4) {
-                return *board[*cell];
-            }
-        }
-        else {
-            consecutive_tokens = 1;
-        }
-        index++;
-        prev_cell = cell;
-        cell      = index_generator(index);
-    }
-    return std::nullopt;
-}
-
-std::optional<Player> winner_on_row(int row_index, const Board& board)
-{
-    return winner_on_line(board, [&](int index) -> std::optional<CellIndex> {
-        if (0 <= index && index < board.width()) {
-            return std::make_optional(CellIndex{index, row_index});
-        }
-        else {
-            return std::nullopt;
-        }
-    });
-}
-
-std::optional<Player> winner_on_column(int column_index, const Board& board)
-{
-    return winner_on_line(board, [&](int index) -> std::optional<CellIndex> {
-        if (0 <= index && index < board.height()) {
-            return std::make_optional(CellIndex{column_index, index});
-        }
-        else {
-            return std::nullopt;
-        }
-    });
-}
-
-std::optional<Player> winner_on_diagonal(int diagonal_index, const Board& board)
-{
-    const auto first_cell = diagonal_index < board.height() ? CellIndex{0, board.height() - 1 - diagonal_index}
-                                                            : CellIndex{diagonal_index - board.height(), 0};
-    return winner_on_line(board, [&](int index) -> std::optional<CellIndex> {
-        const auto cell = CellIndex{first_cell.x + index, first_cell.y + index};
-        if (cell.x < board.width() && cell.y < board.height()) {
-            return std::make_optional(cell);
-        }
-        else {
-            return std::nullopt;
-        }
-    });
-}
-
-std::optional<Player> winner_on_anti_diagonal(int diagonal_index, const Board& board)
-{
-    const auto first_cell = diagonal_index < board.height() ? CellIndex{0, diagonal_index}
-                                                            : CellIndex{diagonal_index - board.height(), board.height() - 1};
-    return winner_on_line(board, [&](int index) -> std::optional<CellIndex> {
-        const auto cell = CellIndex{first_cell.x + index, first_cell.y - index};
-        if (cell.x < board.width() && cell.y >= 0) {
-            return std::make_optional(cell);
-        }
-        else {
-            return std::nullopt;
-        }
-    });
-}
-
-std::optional<Player> winner_on_lines(const Board& board, int max_iterations,
-                                      std::function<std::optional<Player>(int, const Board&)> check_for_winner)
-{
-    for (int i = 0; i < max_iterations; ++i) {
-        const auto winner = check_for_winner(i, board);
-        if (winner.has_value()) {
-            return winner;
+        const auto cell = GameRules::landing_cell(board, CellIndex{*hovered_column, 0});
+        if (cell.has_value()) {
+            draw_token(*cell, board.size(), player, ctx, true);
         }
     }
-    return std::nullopt;
 }
 
-std::optional<Player> winner_on_rows(const Board& board)
+template<typename GameRules>
+std::optional<Player> check_for_winner(const BoardFor<GameRules>& board)
 {
-    return winner_on_lines(board,
-                           board.height(),
-                           &winner_on_row);
-}
-
-std::optional<Player> winner_on_columns(const Board& board)
-{
-    return winner_on_lines(board,
-                           board.width(),
-                           &winner_on_column);
-}
-
-std::optional<Player> winner_on_diagonals(const Board& board)
-{
-    return winner_on_lines(board,
-                           board.width() + board.height() - 1,
-                           &winner_on_diagonal);
-}
-
-std::optional<Player> winner_on_anti_diagonals(const Board& board)
-{
-    return winner_on_lines(board,
-                           board.width() + board.height() - 1,
-                           &winner_on_anti_diagonal);
-}
-
-std::optional<Player> check_for_winner(const Board& board)
-{
-    auto winner = winner_on_rows(board);
-    if (!winner.has_value()) {
-        winner = winner_on_columns(board);
-    }
-    if (!winner.has_value()) {
-        winner = winner_on_diagonals(board);
-    }
-    if (!winner.has_value()) {
-        winner = winner_on_anti_diagonals(board);
-    }
-    return winner;
+    return GameRules::winner(board, Player::Red, Player::Yellow);
 }
 
 const char* to_string(Player player)
@@ -240,14 +108,15 @@ const char* to_string(Player player)
     }
 }
 
-bool game_is_over(const Board& board)
+template<typename GameRules>
+bool game_is_over(const BoardFor<GameRules>& board)
 {
     if (board_is_full(board)) {
         std::cout << "This is a draw!\n";
         return true;
     }
     else {
-        const auto winner = check_for_winner(board);
+        const auto winner = check_for_winner<GameRules>(board);
         if (winner.has_value()) {
             std::cout << to_string(*winner) << " has won!\n";
         }
@@ -255,16 +124,38 @@ bool game_is_over(const Board& board)
     }
 }
 
-void play_connect_4()
+/// Looks up in the tablebase who wins if both players play perfectly from now on
+template<typename GameRules>
+void show_perfect_play_result(const BoardFor<GameRules>& board, Player current_player, const Tablebase& tablebase)
+{
+    if (check_for_winner<GameRules>(board).has_value() || board_is_full(board)) {
+        return;
+    }
+    switch (tablebase.result(MnkGame<GameRules>::index_of(board, Player::Red))) { // Red always starts
+    case GameResult::Win: std::cout << to_string(current_player) << " can force a win\n"; break;
+    case GameResult::Loss: std::cout << to_string(current_player) << " will lose against perfect play\n"; break;
+    case GameResult::Draw: std::cout << "This is a draw with perfect play\n"; break;
+    case GameResult::Unknown: break;
+    }
+}
+
+/// `tablebase_file` is only used if the tablebase has been generated with the build-tablebase tool
+template<typename GameRules>
+void play_connect_n(const char* title, std::optional<std::string_view> tablebase_file)
 {
-    auto ctx            = p6::Context{{1200, 800, "Connect 4"}};
-    auto board          = Board{};
-    auto current_player = Player::Red;
-    ctx.mouse_pressed   = [&](auto) {
+    auto       ctx            = p6::Context{{1200, 800, title}};
+    auto       board          = BoardFor<GameRules>{};
+    auto       current_player = Player::Red;
+    const auto tablebase      = tablebase_file.has_value() ? Tablebase::open(*tablebase_file, MnkGame<GameRules>::positions_count)
+                                                           : std::nullopt;
+    ctx.mouse_pressed         = [&](auto) {
         const auto column_index = column_at(ctx.mouse(), board.size());
         if (column_index.has_value()) {
-            if (try_to_play_in_column(*column_index, current_player, board)) {
+            if (try_to_play_in_column<GameRules>(*column_index, current_player, board)) {
                 current_player = next_player(current_player);
+                if (tablebase.has_value()) {
+                    show_perfect_play_result<GameRules>(board, current_player, *tablebase);
+                }
             }
         }
     };
@@ -273,12 +164,22 @@ void play_connect_4()
         ctx.fill = {1.f, 1.f, 1.f, 0.95f};
         draw_board(board.size(), ctx);
         draw_tokens(board, ctx);
-        preview_token_at(ctx.mouse(), board, current_player, ctx);
-        if (game_is_over(board)) {
+        preview_token_at<GameRules>(ctx.mouse(), board, current_player, ctx);
+        if (game_is_over<GameRules>(board)) {
             using namespace std::chrono_literals;
             std::this_thread::sleep_for(2s);
             ctx.stop();
         }
     };
     ctx.start();
+}
+
+void play_connect_4()
+{
+    play_connect_n<Connect4Rules>("Connect 4", std::nullopt); // Its tablebase would be way too big
+}
+
+void play_connect_3()
+{
+    play_connect_n<Connect3Rules>("Connect 3", connect_3_tablebase_file);
 }
\ No newline at end of file
@@ -1,3 +1,11 @@
 #pragma once
+#include <string_view>
+#include "game_rules.h"
 
-void play_connect_4();
\ No newline at end of file
+void play_connect_4();
+void play_connect_3();
+
+using Connect4Rules = Rules<7, 6, 4, DropInColumn>;
+using Connect3Rules = Rules<5, 4, 3, DropInColumn>;
+
+inline constexpr std::string_view connect_3_tablebase_file = "connect_3.tablebase";
@@ -0,0 +1,300 @@
+#include "dawg.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+#include "options.h"
+#include "pattern_index.h"
+#include "rand.h"
+
+/// The file starts with this header, and then contains the edges, starting with the ones of the root
+struct DawgHeader {
+    std::array<char, 8> magic_number;
+    uint64_t            edges_count;
+    uint64_t            words_count;
+};
+
+static constexpr std::array<char, 8> dawg_magic_number = {'D', 'A', 'W', 'G', '0', '0', '0', '1'};
+
+std::optional<Dawg> Dawg::open(const std::filesystem::path& path)
+{
+    auto file = MemoryMappedFile::open(path);
+    if (!file.has_value() || file->size() < sizeof(DawgHeader)) {
+        return std::nullopt;
+    }
+    auto header = DawgHeader{};
+    std::memcpy(&header, file->data(), sizeof(header));
+    if (header.magic_number != dawg_magic_number || file->size() != sizeof(DawgHeader) + header.edges_count * sizeof(DawgEdge)) {
+        return std::nullopt;
+    }
+    return std::make_optional(Dawg{std::move(*file)});
+}
+
+uint64_t Dawg::words_count() const
+{
+    auto header = DawgHeader{};
+    std::memcpy(&header, _file.data(), sizeof(header));
+    return header.words_count;
+}
+
+const DawgEdge* Dawg::edges() const
+{
+    return reinterpret_cast<const DawgEdge*>(_file.data() + sizeof(DawgHeader)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+}
+
+std::string Dawg::random_word() const
+{
+    // The words are numbered in alphabetical order, and each edge knows how many of them it leads to,
+    // so we can walk down to the n-th word without looking at the other ones
+    auto n    = rand<uint64_t>(0, words_count() - 1);
+    auto word = std::string{};
+    for (const auto* edge = edges();;) {
+        if (n >= edge->words_count) {
+            n -= edge->words_count;
+            ++edge;
+            continue;
+        }
+        word += edge->letter();
+        if (edge->ends_word()) {
+            if (n == 0) {
+                return word;
+            }
+            n--;
+        }
+        edge = edges() + edge->target();
+    }
+}
+
+/// A node of the graph while it is being built, before it gets written as a list of edges
+struct DawgBuilderNode {
+    std::vector<std::pair<char, uint32_t>> children; // The letter and the index of the child, in alphabetical order
+    bool                                   ends_word{false};
+};
+
+/// Builds the minimal graph incrementally, with the algorithm of Daciuk, Mihov, Watson and Watson:
+/// the words come in alphabetical order, so once a word has been added, the nodes that are not on the path of the next word will never change again.
+/// We replace each of them with an identical node that we already have, if there is one, otherwise it becomes the reference for its kind of node.
+class DawgBuilder {
+public:
+    DawgBuilder()
+        : _nodes(1) // The root
+    {
+    }
+
+    /// The words must be added in alphabetical order
+    void add(std::string_view word)
+    {
+        size_t common_prefix_length = 0;
+        while (common_prefix_length < std::min(word.size(), _previous_word.size()) && word[common_prefix_length] == _previous_word[common_prefix_length]) {
+            common_prefix_length++;
+        }
+        merge_unchecked_nodes(common_prefix_length);
+        auto node = _unchecked_nodes.empty() ? uint32_t{0} : _unchecked_nodes.back().child;
+        for (size_t i = common_prefix_length; i < word.size(); ++i) {
+            const auto child = static_cast<uint32_t>(_nodes.size());
+            _nodes.emplace_back();
+            _nodes[node].children.emplace_back(word[i], child);
+            _unchecked_nodes.push_back({node, child});
+            node = child;
+        }
+        _nodes[node].ends_word = true;
+        _previous_word         = word;
+    }
+
+    struct Graph {
+        std::vector<DawgBuilderNode> nodes;           // The ones that have been merged into another one are still there, but nothing leads to them anymore
+        std::vector<uint32_t>        bottom_up_order; // The nodes that are used, each one after all its children
+    };
+
+    Graph finish()
+    {
+        merge_unchecked_nodes(0);
+        _bottom_up_order.push_back(0);
+        return {std::move(_nodes), std::move(_bottom_up_order)};
+    }
+
+private:
+    struct UncheckedNode {
+        uint32_t parent;
+        uint32_t child;
+    };
+
+    void merge_unchecked_nodes(size_t remaining_count)
+    {
+        while (_unchecked_nodes.size() > remaining_count) {
+            const auto [parent, child] = _unchecked_nodes.back();
+            _unchecked_nodes.pop_back();
+            const auto [same_node, is_new] = _checked_nodes.emplace(signature_of(_nodes[child]), child);
+            if (is_new) {
+                _bottom_up_order.push_back(child);
+            }
+            else {
+                _nodes[parent].children.back().second = same_node->second;
+                _nodes[child]                         = DawgBuilderNode{}; // Frees its memory
+            }
+        }
+    }
+
+    /// Two nodes are identical iff they have the same signature. Their children are always checked nodes, so comparing their indices is enough.
+    static std::string signature_of(const DawgBuilderNode& node)
+    {
+        auto signature = std::string(1, node.ends_word ? '1' : '0');
+        for (const auto& [letter, child] : node.children) {
+            signature += letter;
+            signature.append(reinterpret_cast<const char*>(&child), sizeof(child)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        }
+        return signature;
+    }
+
+private:
+    std::vector<DawgBuilderNode>              _nodes;
+    std::vector<uint32_t>                     _bottom_up_order; // A node is only checked once all its children have been
+    std::vector<UncheckedNode>                _unchecked_nodes; // The path of the previous word, whose nodes may still get new children
+    std::unordered_map<std::string, uint32_t> _checked_nodes;   // The nodes that will never change, by signature
+    std::string_view                          _previous_word;
+};
+
+/// Turns the nodes into lists of edges, the root first
+static std::vector<DawgEdge> edges_of(const DawgBuilder::Graph& graph)
+{
+    const auto& nodes = graph.nodes;
+    struct NodeSummary {
+        uint32_t first_edge{0};
+        uint32_t words_count{0};
+        uint32_t suffix_lengths{0}; // Same as DawgEdge::suffix_lengths, for the words that end after the node
+        bool     is_placed{false};
+    };
+    auto summaries = std::vector<NodeSummary>(nodes.size());
+    for (const auto node : graph.bottom_up_order) {
+        auto& summary = summaries[node];
+        if (nodes[node].ends_word) {
+            summary.words_count    = 1;
+            summary.suffix_lengths = 1;
+        }
+        for (const auto& [letter, child] : nodes[node].children) {
+            summary.words_count += summaries[child].words_count;
+            const auto child_suffix_lengths = summaries[child].suffix_lengths;
+            summary.suffix_lengths |= (child_suffix_lengths << 1) | (child_suffix_lengths & (uint32_t{1} << 31)); // The last bit stays for all the longer suffixes
+        }
+    }
+
+    // The root goes first, then each node goes after the ones we have already written, in the order we discover them
+    auto edges       = std::vector<DawgEdge>{};
+    auto nodes_order = std::vector<uint32_t>{0};
+    auto edges_count = static_cast<uint32_t>(nodes[0].children.size());
+
+    summaries[0].is_placed = true;
+    for (size_t next = 0; next < nodes_order.size(); ++next) {
+        for (const auto& [letter, child] : nodes[nodes_order[next]].children) {
+            if (!summaries[child].is_placed && !nodes[child].children.empty()) {
+                summaries[child].is_placed  = true;
+                summaries[child].first_edge = edges_count;
+                edges_count += static_cast<uint32_t>(nodes[child].children.size());
+                nodes_order.push_back(child);
+            }
+        }
+    }
+    edges.reserve(edges_count);
+    for (const auto node : nodes_order) {
+        const auto& children = nodes[node].children;
+        for (size_t i = 0; i < children.size(); ++i) {
+            const auto [letter, child] = children[i];
+            const auto& child_summary  = summaries[child];
+            auto        edge           = DawgEdge{};
+            edge.letter_and_target     = static_cast<uint32_t>(letter - 'a') | (child_summary.first_edge << DawgEdge::target_shift);
+            if (nodes[child].ends_word) {
+                edge.letter_and_target |= DawgEdge::ends_word_bit;
+            }
+            if (i == children.size() - 1) {
+                edge.letter_and_target |= DawgEdge::last_edge_bit;
+            }
+            edge.words_count    = child_summary.words_count;
+            edge.suffix_lengths = child_summary.suffix_lengths;
+            edges.push_back(edge);
+        }
+    }
+    return edges;
+}
+
+bool save_dawg(const Dictionary& dictionary, const std::filesystem::path& path)
+{
+    auto words = std::vector<std::string_view>{};
+    words.reserve(dictionary.words_count());
+    for (size_t length = 1; length <= dictionary.max_length(); ++length) {
+        words.insert(words.end(), dictionary.words_with_length(length).begin(), dictionary.words_with_length(length).end());
+    }
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+
+    auto builder = DawgBuilder{};
+    for (const auto word : words) {
+        builder.add(word);
+    }
+    const auto edges = edges_of(builder.finish());
+    if (edges.size() >= DawgEdge::max_edges_count) {
+        return false;
+    }
+
+    auto file = std::ofstream{path, std::ios::binary};
+    if (!file) {
+        return false;
+    }
+    const auto header = DawgHeader{dawg_magic_number, edges.size(), words.size()};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    file.write(reinterpret_cast<const char*>(edges.data()),             // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+               static_cast<std::streamsize>(edges.size() * sizeof(DawgEdge)));
+    return static_cast<bool>(file);
+}
+
+int build_dawg(const std::vector<std::string_view>& arguments)
+{
+    const auto dictionary_path = option("dictionary");
+    if (!dictionary_path.has_value() || arguments.empty()) {
+        std::cout << "Usage: --dictionary <file> build-dawg <output file>\n";
+        return 1;
+    }
+    const auto dictionary = Dictionary::open(*dictionary_path);
+    if (!dictionary.has_value()) {
+        std::cout << "Could not read \"" << *dictionary_path << "\"\n";
+        return 1;
+    }
+    const auto path  = std::filesystem::path{arguments[0]};
+    const auto begin = std::chrono::steady_clock::now();
+    if (!save_dawg(*dictionary, path)) {
+        std::cout << "Could not write \"" << path.string() << "\"\n";
+        return 1;
+    }
+    const auto end  = std::chrono::steady_clock::now();
+    const auto dawg = Dawg::open(path);
+    if (!dawg.has_value()) {
+        std::cout << "Could not read back \"" << path.string() << "\"\n";
+        return 1;
+    }
+    std::cout << "Built in " << std::chrono::duration<double>{end - begin}.count() << "s: "
+              << dawg->words_count() << " different words in " << std::filesystem::file_size(path) << " bytes, from a dictionary of "
+              << std::filesystem::file_size(*dictionary_path) << " bytes\n";
+
+    // Checks that the graph finds the same words as the dictionary, for patterns like the ones of a hangman game
+    for (int i = 0; i < 100; ++i) {
+        const auto word    = dictionary->random_word();
+        auto       pattern = std::string(word.size(), '_');
+        for (size_t position = 0; position < word.size(); ++position) {
+            if (word[position] == word[0]) {
+                pattern[position] = word[0];
+            }
+        }
+        size_t matches_count = 0;
+        dawg->for_each_word_matching(pattern, 0, [&](std::string_view) { matches_count++; });
+        auto expected_matches = words_matching_by_linear_scan(*dictionary, pattern, 0);
+        std::sort(expected_matches.begin(), expected_matches.end());
+        expected_matches.erase(std::unique(expected_matches.begin(), expected_matches.end()), expected_matches.end());
+        if (matches_count != expected_matches.size()) {
+            std::cout << "The graph has " << matches_count << " words that match \"" << pattern << "\" instead of " << expected_matches.size() << "!\n";
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "dictionary.h"
+#include "memory_mapped_file.h"
+#include "word_with_missing_letters.h"
+
+/// One letter of a word in a Dawg file
+/// The edges that leave a node are stored next to each other, and a node is designated by the index of its first edge.
+struct DawgEdge {
+    uint32_t letter_and_target; // The letter (5 bits), whether a word ends with it (1 bit), whether it is the last edge of its node (1 bit), and the node it leads to (25 bits)
+    uint32_t words_count;       // How many words go through this edge
+    uint32_t suffix_lengths;    // Bit n is set if a word ends n letters after this one. The last bit is for all the words that end 31 letters or more after it.
+
+    static constexpr uint32_t ends_word_bit   = 1u << 5;
+    static constexpr uint32_t last_edge_bit   = 1u << 6;
+    static constexpr int      target_shift    = 7;
+    static constexpr uint32_t max_edges_count = 1u << (32 - target_shift);
+
+    char     letter() const { return static_cast<char>('a' + (letter_and_target & 0b11111)); }
+    bool     ends_word() const { return letter_and_target & ends_word_bit; }
+    bool     is_last_edge() const { return letter_and_target & last_edge_bit; }
+    uint32_t target() const { return letter_and_target >> target_shift; } // 0 when no word continues after this letter, since nothing leads to the root
+
+    bool has_suffix_of_length(size_t length) const { return suffix_lengths & (uint32_t{1} << std::min(length, size_t{31})); }
+};
+
+/// A dictionary stored as a directed acyclic word graph: a trie whose identical branches are merged,
+/// so that the words that share their beginning or their end share their storage.
+/// The file is memory-mapped and used as is: finding a random word or the words that match a hangman pattern
+/// only reads the parts of the graph that lead to them, and never decompresses the whole list.
+class Dawg {
+public:
+    /// Returns std::nullopt if the file doesn't exist or is not a Dawg file
+    static std::optional<Dawg> open(const std::filesystem::path& path);
+
+    uint64_t words_count() const;
+
+    /// Returns one of the words, they all have the same probability to be picked
+    /// The dawg must not be empty
+    std::string random_word() const;
+
+    /// Calls `callback` with each word that matches `pattern`, where '_' is a letter that hasn't been revealed yet,
+    /// and that contains none of the `excluded_letters`. Like in hangman, a revealed letter can't be under a '_'.
+    template<typename Callback>
+    void for_each_word_matching(std::string_view pattern, LetterMask excluded_letters, Callback&& callback) const
+    {
+        LetterMask revealed_letters = 0;
+        for (const char letter : pattern) {
+            if (letter != '_') {
+                revealed_letters |= letter_bit(letter);
+            }
+        }
+        auto word = std::string(pattern.size(), '_');
+        if (!pattern.empty() && pattern.size() <= Dictionary::max_word_length && words_count() != 0) {
+            match_from(0, 0, pattern, revealed_letters | excluded_letters, word, callback);
+        }
+    }
+
+private:
+    explicit Dawg(MemoryMappedFile file)
+        : _file{std::move(file)}
+    {
+    }
+
+    const DawgEdge* edges() const;
+
+    template<typename Callback>
+    void match_from(uint32_t node, size_t depth, std::string_view pattern, LetterMask letters_not_under_blanks, std::string& word, Callback& callback) const
+    {
+        const auto remaining_length = pattern.size() - depth - 1;
+        for (const auto* edge = edges() + node;; ++edge) {
+            const char letter      = edge->letter();
+            const bool letter_fits = pattern[depth] == '_' ? !(letters_not_under_blanks & letter_bit(letter))
+                                                           : pattern[depth] == letter;
+            const bool length_fits = edge->has_suffix_of_length(remaining_length); // Skips the branches that don't have any word of the right length
+            if (letter_fits && length_fits) {
+                word[depth] = letter;
+                if (remaining_length == 0) {
+                    callback(std::string_view{word});
+                }
+                else {
+                    match_from(edge->target(), depth + 1, pattern, letters_not_under_blanks, word, callback);
+                }
+            }
+            if (edge->is_last_edge()) {
+                break;
+            }
+        }
+    }
+
+private:
+    MemoryMappedFile _file;
+};
+
+/// Builds the Dawg of all the words of `dictionary` and saves it to `path`
+/// Returns false iff the file could not be written
+bool save_dawg(const Dictionary& dictionary, const std::filesystem::path& path);
+
+/// Builds the Dawg of the dictionary given with `--dictionary <file>`, saves it to the file given in `arguments`
+/// and checks that it contains the same words
+int build_dawg(const std::vector<std::string_view>& arguments);
@@ -0,0 +1,66 @@
+#include "dictionary.h"
+#include <algorithm>
+#include <cstring>
+#include "rand.h"
+
+bool is_made_of_lowercase_letters(std::string_view word)
+{
+    return std::all_of(word.begin(), word.end(), [](char letter) {
+        return 'a' <= letter && letter <= 'z';
+    });
+}
+
+std::optional<Dictionary> Dictionary::open(const std::filesystem::path& path)
+{
+    auto file = MemoryMappedFile::open(path);
+    if (!file.has_value()) {
+        return std::nullopt;
+    }
+    return std::make_optional(Dictionary{std::move(*file)});
+}
+
+Dictionary::Dictionary(MemoryMappedFile file)
+    : _file{std::move(file)}
+{
+    const char*       line_begin = _file.data();
+    const char* const file_end   = _file.data() + _file.size();
+    while (line_begin < file_end) {
+        const auto* line_end = static_cast<const char*>(std::memchr(line_begin, '\n', static_cast<size_t>(file_end - line_begin)));
+        if (line_end == nullptr) {
+            line_end = file_end;
+        }
+        auto word = std::string_view{line_begin, static_cast<size_t>(line_end - line_begin)};
+        if (!word.empty() && word.back() == '\r') { // Files written on Windows
+            word.remove_suffix(1);
+        }
+        if (!word.empty() && word.size() <= max_word_length && is_made_of_lowercase_letters(word)) {
+            if (word.size() >= _words_by_length.size()) {
+                _words_by_length.resize(word.size() + 1);
+            }
+            _words_by_length[word.size()].push_back(word);
+            _words_count++;
+        }
+        line_begin = line_end + 1;
+    }
+}
+
+const std::vector<std::string_view>& Dictionary::words_with_length(size_t length) const
+{
+    static const auto no_words = std::vector<std::string_view>{};
+    if (length >= _words_by_length.size()) {
+        return no_words;
+    }
+    return _words_by_length[length];
+}
+
+std::string_view Dictionary::random_word() const
+{
+    auto index = rand<size_t>(0, _words_count - 1);
+    for (const auto& words : _words_by_length) {
+        if (index < words.size()) {
+            return words[index];
+        }
+        index -= words.size();
+    }
+    return {}; // Unreachable because index < _words_count
+}
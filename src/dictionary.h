@@ -0,0 +1,42 @@
+#pragma once
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <vector>
+#include "memory_mapped_file.h"
+
+/// A list of words read from a file that contains one word per line
+/// The file is memory-mapped and the words are views into it: nothing is copied,
+/// so that even dictionaries of several megabytes are ready a few milliseconds after opening them.
+/// Only the words made of lowercase letters from 'a' to 'z' are kept.
+class Dictionary {
+public:
+    /// Longer words are ignored, so that the letters of each word fit in a 64 bit mask (see WordWithMissingLetters)
+    static constexpr size_t max_word_length = 64;
+
+    /// Returns std::nullopt if the file can't be opened
+    static std::optional<Dictionary> open(const std::filesystem::path& path);
+
+    /// All the words that have `length` letters
+    const std::vector<std::string_view>& words_with_length(size_t length) const;
+
+    /// The lengths go from 0 to max_length() (included)
+    size_t max_length() const { return _words_by_length.size() - 1; }
+
+    size_t words_count() const { return _words_count; }
+
+    /// Returns one of the words, they all have the same probability to be picked
+    /// The dictionary must not be empty
+    std::string_view random_word() const;
+
+private:
+    explicit Dictionary(MemoryMappedFile file);
+
+private:
+    MemoryMappedFile                           _file;
+    std::vector<std::vector<std::string_view>> _words_by_length{1}; // Indexed by the length of the words
+    size_t                                     _words_count{0};
+};
+
+/// Returns true iff `word` is only made of lowercase letters from 'a' to 'z'
+bool is_made_of_lowercase_letters(std::string_view word);
@@ -0,0 +1,200 @@
+#include "evil_hangman.h"
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "get_input_from_user.h"
+#include "hangman.h"
+#include "screen.h"
+#include "word_with_missing_letters.h"
+
+/// Counts how many times each key has been added, in a flat hash table with linear probing
+/// The table is kept from one guess to the next, and clearing it only touches the slots that have been used,
+/// so that the guesses don't allocate anything once the table has grown to the number of different keys.
+/// It starts small since there are a lot fewer keys than words, so that it stays in the cache.
+class KeyCounter {
+public:
+    struct Slot {
+        uint64_t key;
+        uint32_t count{0}; // 0 for the slots that are not used
+    };
+
+    KeyCounter()
+        : _slots(1024)
+    {
+    }
+
+    void clear()
+    {
+        for (const auto slot : _used_slots) {
+            _slots[slot].count = 0;
+        }
+        _used_slots.clear();
+    }
+
+    void add(uint64_t key)
+    {
+        auto* slot = &find_slot(key);
+        if (slot->count == 0) {
+            if ((_used_slots.size() + 1) * 2 > _slots.size()) { // Keeps the table at most half full, so that the probe sequences stay short
+                grow();
+                slot = &find_slot(key);
+            }
+            slot->key = key;
+            _used_slots.push_back(static_cast<uint32_t>(slot - _slots.data()));
+        }
+        slot->count++;
+    }
+
+    template<typename Callback>
+    void for_each(Callback&& callback) const
+    {
+        for (const auto slot : _used_slots) {
+            callback(_slots[slot]);
+        }
+    }
+
+private:
+    Slot& find_slot(uint64_t key)
+    {
+        const auto mask = _slots.size() - 1;
+        auto       slot = static_cast<size_t>((key * 0x9E3779B97F4A7C15) >> 32) & mask; // Fibonacci hashing spreads the bits of the masks
+        while (_slots[slot].count != 0 && _slots[slot].key != key) {
+            slot = (slot + 1) & mask;
+        }
+        return _slots[slot];
+    }
+
+    void grow()
+    {
+        const auto old_slots      = std::exchange(_slots, std::vector<Slot>(_slots.size() * 2));
+        const auto old_used_slots = std::exchange(_used_slots, {});
+        for (const auto old_slot : old_used_slots) {
+            auto& slot = find_slot(old_slots[old_slot].key);
+            slot       = old_slots[old_slot];
+            _used_slots.push_back(static_cast<uint32_t>(&slot - _slots.data()));
+        }
+    }
+
+private:
+    std::vector<Slot>     _slots;
+    std::vector<uint32_t> _used_slots;
+};
+
+/// The word that the computer pretends to have chosen: all the words that match what has been revealed so far
+class EvilWord {
+public:
+    /// All the `words` must have the same length
+    explicit EvilWord(const std::vector<std::string_view>& words)
+        : _length{words.front().size()}
+        , _pattern(_length, '_')
+    {
+        // The words are copied next to each other: going through them is several times faster than following views into the dictionary file.
+        // All the memory that the guesses need is allocated here, so that the first guess is as fast as the other ones.
+        _words.reserve(words.size() * _length);
+        _candidates.reserve(words.size());
+        for (const auto word : words) {
+            _candidates.push_back(static_cast<uint32_t>(_candidates.size()));
+            _words.append(word);
+        }
+        _positions.resize(words.size());
+    }
+
+    /// Keeps the biggest group of the words that have `letter` at the same positions, and returns these positions (0 if the letter is a miss)
+    uint64_t guess(char letter)
+    {
+        _counter.clear();
+        // We don't skip the words that don't have the letter (with letter masks for example): the CPU can't predict that branch,
+        // so it is faster to look at all the words
+        for (size_t i = 0; i < _candidates.size(); ++i) {
+            _positions[i] = positions_of(letter, word_at(_candidates[i]));
+            _counter.add(_positions[i]);
+        }
+        // Ties are broken in favour of the group that reveals the fewest letters, which is the misses if they are one of them
+        auto best = KeyCounter::Slot{0, 0};
+        _counter.for_each([&](const KeyCounter::Slot& slot) {
+            if (slot.count > best.count || (slot.count == best.count && bits_count(slot.key) < bits_count(best.key))) {
+                best = slot;
+            }
+        });
+
+        size_t kept = 0;
+        for (size_t i = 0; i < _candidates.size(); ++i) {
+            if (_positions[i] == best.key) {
+                _candidates[kept++] = _candidates[i];
+            }
+        }
+        _candidates.resize(kept);
+        for (size_t i = 0; i < _length; ++i) {
+            if (best.key & (uint64_t{1} << i)) {
+                _pattern[i] = letter;
+            }
+        }
+        return best.key;
+    }
+
+    const std::string& pattern() const { return _pattern; }
+    bool               is_fully_revealed() const { return _pattern.find('_') == std::string::npos; }
+
+    /// A word that the computer could have been thinking of from the start
+    std::string_view word() const { return word_at(_candidates.front()); }
+
+private:
+    std::string_view word_at(size_t index) const { return {_words.data() + index * _length, _length}; }
+
+    static int bits_count(uint64_t bits)
+    {
+        int count = 0;
+        for (; bits != 0; bits &= bits - 1) {
+            count++;
+        }
+        return count;
+    }
+
+private:
+    size_t                _length;
+    std::string           _pattern;
+    std::string           _words;      // All the words of the length of the pattern, one after the other
+    std::vector<uint32_t> _candidates; // The indices of the words that are still possible, in increasing order so that we go through _words in order
+    std::vector<uint64_t> _positions;  // The positions of the guessed letter in each candidate. Reused from one guess to the next
+    KeyCounter            _counter;
+};
+
+void show_pattern(Screen& screen, const std::string& pattern)
+{
+    for (const char letter : pattern) {
+        screen << letter << ' ';
+    }
+    screen << '\n';
+}
+
+void play_evil_hangman()
+{
+    const auto& dictionary = hangman_dictionary();
+    if (!dictionary.has_value()) {
+        std::cout << "Evil Hangman needs a lot of words, please start the program with --dictionary <file>\n";
+        return;
+    }
+    auto word            = EvilWord{dictionary->words_with_length(dictionary->random_word().size())};
+    int  number_of_lives = hangman_lives_count;
+    auto screen          = Screen{};
+    while (player_is_alive(number_of_lives) && !word.is_fully_revealed()) {
+        show_number_of_lives(screen, number_of_lives);
+        show_pattern(screen, word.pattern());
+        screen.present();
+        const auto guess = get_input_from_user<char>();
+        if (is_lowercase_letter(guess) && word.pattern().find(guess) != std::string::npos) { // Guessing a letter that is already revealed doesn't cost anything, like in the normal hangman
+            continue;
+        }
+        if (!is_lowercase_letter(guess) || word.guess(guess) == 0) {
+            remove_one_life(number_of_lives);
+        }
+    }
+    if (word.is_fully_revealed()) {
+        show_congrats_message(screen, word.word());
+    }
+    else {
+        show_defeat_message(screen, word.word());
+    }
+    screen.present();
+}
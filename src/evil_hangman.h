@@ -0,0 +1,5 @@
+#pragma once
+
+/// Hangman where the computer never chooses a word: after each guess it keeps the biggest group of the words that are still possible.
+/// Needs a dictionary, given with `--dictionary <file>`.
+void play_evil_hangman();
@@ -0,0 +1,185 @@
+#include "game_coroutine.h"
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include "hangman.h"
+#include "play_guess_the_number.h"
+#include "session.h"
+
+struct FramePoolState {
+    static constexpr size_t granularity     = 64; // The sizes are rounded up to a multiple of it, so that the frames of similar sizes share their lists
+    static constexpr size_t max_pooled_size = 4096;
+    static constexpr size_t block_size      = 1 << 16;
+
+    std::array<void*, max_pooled_size / granularity + 1> free_frames{}; // The first bytes of a free frame point to the next free frame of the same size
+    std::vector<std::unique_ptr<std::byte[]>>             blocks;
+    std::byte*                                            block_position{nullptr};
+    size_t                                                block_size_left{0};
+    size_t                                                used_bytes{0};
+};
+
+static FramePoolState& frame_pool()
+{
+    thread_local auto pool = FramePoolState{};
+    return pool;
+}
+
+void* FramePool::allocate(size_t size)
+{
+    auto&      pool         = frame_pool();
+    const auto size_class   = (size + FramePoolState::granularity - 1) / FramePoolState::granularity;
+    const auto rounded_size = size_class * FramePoolState::granularity;
+    if (rounded_size > FramePoolState::max_pooled_size) {
+        pool.used_bytes += size;
+        return ::operator new(size);
+    }
+    pool.used_bytes += rounded_size;
+    if (auto* frame = pool.free_frames[size_class]; frame != nullptr) {
+        pool.free_frames[size_class] = *static_cast<void**>(frame);
+        return frame;
+    }
+    if (pool.block_size_left < rounded_size) { // The end of the current block is lost, but it is smaller than a frame
+        pool.blocks.push_back(std::make_unique<std::byte[]>(FramePoolState::block_size));
+        pool.block_position  = pool.blocks.back().get();
+        pool.block_size_left = FramePoolState::block_size;
+    }
+    auto* frame = pool.block_position;
+    pool.block_position += rounded_size;
+    pool.block_size_left -= rounded_size;
+    return frame;
+}
+
+void FramePool::deallocate(void* frame, size_t size)
+{
+    auto&      pool         = frame_pool();
+    const auto size_class   = (size + FramePoolState::granularity - 1) / FramePoolState::granularity;
+    const auto rounded_size = size_class * FramePoolState::granularity;
+    if (rounded_size > FramePoolState::max_pooled_size) {
+        pool.used_bytes -= size;
+        ::operator delete(frame);
+        return;
+    }
+    pool.used_bytes -= rounded_size;
+    *static_cast<void**>(frame)  = pool.free_frames[size_class];
+    pool.free_frames[size_class] = frame;
+}
+
+size_t FramePool::used_bytes()
+{
+    return frame_pool().used_bytes;
+}
+
+bool SessionInputs::give(std::string_view line)
+{
+    if (!_waiting_game || !_parse(line, _input)) {
+        return false;
+    }
+    std::exchange(_waiting_game, {}).resume();
+    return true;
+}
+
+void play_until_over(const GameTask& game, SessionInputs& inputs, Screen& screen)
+{
+    auto& user_input = session_input();
+    screen.present();
+    while (!game.is_over()) {
+        const auto line = user_input.next_line();
+        if (!line.has_value()) {
+            std::exit(0); // NOLINT(concurrency-mt-unsafe)
+        }
+        if (is_blank(*line)) {
+            continue;
+        }
+        if (inputs.give(*line)) {
+            session_log() << *line << std::endl; // Flushed so that the log is complete even if the program crashes
+        }
+        else {
+            screen << "Invalid input, try again!\n";
+        }
+        screen.present();
+    }
+}
+
+/// Creates `sessions_count` games with `create_game`, and gives them the inputs of `next_input` until they are all over
+/// `next_input(session, screen)` returns the input of the bot that plays `session`, given what the game has shown since its previous input.
+template<typename CreateGame, typename NextInput>
+static void measure_sessions(const char* name, size_t sessions_count, CreateGame&& create_game, NextInput&& next_input)
+{
+    auto inputs  = std::vector<SessionInputs>(sessions_count);
+    auto screens = std::vector<Screen>(sessions_count);
+    auto games   = std::vector<GameTask>{};
+    games.reserve(sessions_count);
+
+    const auto begin = std::chrono::steady_clock::now();
+    for (size_t session = 0; session < sessions_count; ++session) {
+        games.push_back(create_game(inputs[session], screens[session]));
+    }
+    const auto frames_bytes = FramePool::used_bytes();
+
+    // Each round gives one input to each game that is not over, like a server that hosts all the sessions would
+    size_t inputs_count  = 0;
+    size_t sessions_left = sessions_count;
+    while (sessions_left != 0) {
+        for (size_t session = 0; session < sessions_count; ++session) {
+            if (games[session].is_over()) {
+                continue;
+            }
+            const auto input = next_input(session, screens[session].text());
+            screens[session].clear();
+            inputs[session].give(input);
+            inputs_count++;
+            if (games[session].is_over()) {
+                sessions_left--;
+            }
+        }
+    }
+    const auto seconds = std::chrono::duration<double>{std::chrono::steady_clock::now() - begin}.count();
+    games.clear();
+
+    std::cout << name << ": " << static_cast<double>(sessions_count) / seconds << " sessions per second and " << static_cast<double>(inputs_count) / seconds / 1e6
+              << " million inputs per second on one thread\n"
+              << "  A suspended session takes " << frames_bytes / sessions_count << " bytes of coroutine frame, plus "
+              << sizeof(SessionInputs) + sizeof(Screen) << " bytes of inputs and screen (and the text of its screen)\n";
+}
+
+int benchmark_game_sessions(const std::vector<std::string_view>& arguments)
+{
+    size_t sessions_count = 100'000;
+    if (!arguments.empty()) {
+        const auto count = parse_input<size_t>(arguments[0]);
+        if (!count.has_value() || *count == 0) {
+            std::cout << "Usage: benchmark-game-sessions [number of sessions, at least 1]\n";
+            return 1;
+        }
+        sessions_count = *count;
+    }
+
+    // The bot of guess the number bisects, and learns whether its previous guess was too small or too big from the screen
+    auto guessers = std::vector<BisectionBot<int>>(sessions_count, BisectionBot<int>{0, 100});
+    auto guesses  = std::vector<std::array<char, 16>>(sessions_count);
+    measure_sessions("Guess the Number", sessions_count, &guess_the_number_game, [&](size_t session, std::string_view screen) {
+        auto& guesser = guessers[session];
+        auto& guess   = guesses[session];
+        if (screen.size() >= 8 && screen.substr(screen.size() - 8) == "Greater\n") {
+            guesser.learn(parse_input<int>(guess.data()).value_or(0), GuessFeedback::Greater);
+        }
+        else if (screen.size() >= 8 && screen.substr(screen.size() - 8) == "Smaller\n") {
+            guesser.learn(parse_input<int>(guess.data()).value_or(0), GuessFeedback::Smaller);
+        }
+        guess             = {};
+        const auto result = std::to_chars(guess.data(), guess.data() + guess.size() - 1, guesser.guess());
+        return std::string_view{guess.data(), static_cast<size_t>(result.ptr - guess.data())};
+    });
+
+    // The bot of hangman guesses the letters from the most frequent one in English to the least frequent one
+    static constexpr std::string_view letters_by_frequency = "etaoinsrhldcumfpgwybvkxjqz";
+    auto                              letters_guessed      = std::vector<size_t>(sessions_count);
+    measure_sessions("Hangman", sessions_count, &hangman_game, [&](size_t session, std::string_view) {
+        return letters_by_frequency.substr(letters_guessed[session]++ % letters_by_frequency.size(), 1);
+    });
+    return 0;
+}
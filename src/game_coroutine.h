@@ -0,0 +1,125 @@
+#pragma once
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "input_source.h"
+#include "screen.h"
+
+/// Gives the memory of the coroutine frames of the games, and takes it back when they are over
+/// The frames of a game always have the same size, so the freed frames are kept in a list per size and reused,
+/// and the new ones are cut from big blocks, instead of going through the general allocator each time a game starts and ends.
+/// Each thread has its own pool, so a game must be destroyed by the thread that created it.
+class FramePool {
+public:
+    static void* allocate(size_t size);
+    static void  deallocate(void* frame, size_t size);
+
+    /// How many bytes the frames of the games that are not destroyed take, on the calling thread
+    static size_t used_bytes();
+};
+
+/// A game that runs as a coroutine: it suspends each time it waits for an input (see SessionInputs), and resumes when it gets it
+/// The game starts as soon as it is created, and runs until it waits for its first input. It is destroyed with its GameTask.
+class GameTask {
+public:
+    struct promise_type {
+        GameTask            get_return_object() { return GameTask{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+        std::suspend_never  initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; } // So that is_over() can still look at the frame
+        void                return_void() {}
+        void                unhandled_exception() { std::terminate(); }
+
+        static void* operator new(size_t size) { return FramePool::allocate(size); }
+        static void  operator delete(void* frame, size_t size) { FramePool::deallocate(frame, size); }
+    };
+
+    GameTask(GameTask&& other) noexcept
+        : _coroutine{std::exchange(other._coroutine, {})}
+    {
+    }
+
+    GameTask& operator=(GameTask&& other) noexcept
+    {
+        std::swap(_coroutine, other._coroutine);
+        return *this;
+    }
+
+    ~GameTask()
+    {
+        if (_coroutine) {
+            _coroutine.destroy();
+        }
+    }
+
+    bool is_over() const { return _coroutine.done(); }
+
+private:
+    explicit GameTask(std::coroutine_handle<promise_type> coroutine)
+        : _coroutine{coroutine}
+    {
+    }
+
+private:
+    std::coroutine_handle<promise_type> _coroutine;
+};
+
+/// The inputs of a game that runs as a coroutine: the game waits for the next one with `co_await inputs.next<T>()`,
+/// and whoever reads them (the console, a script, an InputReactor, a bot, etc.) gives them with give()
+class SessionInputs {
+private:
+    template<typename T>
+    struct Awaiter {
+        SessionInputs&   inputs;
+        std::optional<T> input;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> game)
+        {
+            inputs._waiting_game = game;
+            inputs._parse        = &parse_into<T>;
+            inputs._input        = &input;
+        }
+        T await_resume() { return *input; }
+    };
+
+public:
+    /// Suspends the game until it gets an input of type T
+    template<typename T>
+    Awaiter<T> next() { return Awaiter<T>{*this, std::nullopt}; }
+
+    /// Resumes the game with the input written on `line`, and returns once the game waits for its next input or is over
+    /// Returns false without resuming the game if the line is not a valid input of the type that the game waits for (see parse_input()).
+    bool give(std::string_view line);
+
+    bool is_waiting() const { return static_cast<bool>(_waiting_game); }
+
+private:
+    template<typename T>
+    static bool parse_into(std::string_view line, void* input)
+    {
+        auto value = parse_input<T>(line);
+        if (!value.has_value()) {
+            return false;
+        }
+        *static_cast<std::optional<T>*>(input) = value;
+        return true;
+    }
+
+private:
+    std::coroutine_handle<> _waiting_game;
+    bool (*_parse)(std::string_view line, void* input){nullptr}; // Parses the type that the game waits for into `_input`
+    void* _input{nullptr};
+};
+
+/// Plays `game` until it is over, with the inputs of the session (see session_input()), and presents `screen` each time the game waits for an input
+/// Quits the program once there is nothing left to read, like get_input_from_user().
+void play_until_over(const GameTask& game, SessionInputs& inputs, Screen& screen);
+
+/// Plays many sessions of guess the number and of hangman at the same time on one thread, with bots that give the inputs,
+/// and measures how many sessions per second can be played and how much memory a suspended session takes
+/// `arguments` can contain the number of sessions.
+int benchmark_game_sessions(const std::vector<std::string_view>& arguments);
@@ -0,0 +1,290 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <optional>
+#include "board.h"
+
+/// The rules of the games where two players take turns putting marks on a BoardT, trying to align `line_length` of them.
+/// Each aspect of the rules is a policy chosen at compile time, so that each variant
+/// (Noughts and Crosses, Connect 4, their misère and gravity versions, ...) gets its own fully inlined code, with no runtime dispatch.
+
+/// Used by the code that works for all the games (e.g. the tablebases) instead of each game's own Player type
+enum class Side : uint8_t {
+    First,
+    Second,
+};
+
+inline Side other_side(Side side)
+{
+    return side == Side::First ? Side::Second : Side::First;
+}
+
+/// Returns the first cell of a line of `line_length` identical marks whose first mark satisfies `predicate`, if there is one
+template<int line_length, int width, int height, typename Player, typename Predicate>
+std::optional<CellIndex> find_line(const BoardT<width, height, Player>& board, Predicate&& predicate)
+{
+    static constexpr std::array<CellIndex, 4> directions = {CellIndex{1, 0}, CellIndex{0, 1}, CellIndex{1, 1}, CellIndex{1, -1}};
+    for (int x = 0; x < width; ++x) {
+        for (int y = 0; y < height; ++y) {
+            const auto& first_cell = board[{x, y}];
+            if (!first_cell.has_value() || !predicate(*first_cell)) {
+                continue;
+            }
+            for (const auto direction : directions) {
+                const int last_x = x + (line_length - 1) * direction.x;
+                const int last_y = y + (line_length - 1) * direction.y;
+                if (last_x < 0 || last_x >= width || last_y < 0 || last_y >= height) {
+                    continue;
+                }
+                int aligned = 1;
+                while (aligned < line_length && board[{x + aligned * direction.x, y + aligned * direction.y}] == first_cell) {
+                    aligned++;
+                }
+                if (aligned == line_length) {
+                    return std::make_optional(CellIndex{x, y});
+                }
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+/// Returns the player who has `line_length` marks aligned horizontally, vertically or diagonally, if any
+template<int line_length, int width, int height, typename Player>
+std::optional<Player> player_who_aligned(const BoardT<width, height, Player>& board)
+{
+    const auto line = find_line<line_length>(board, [](Player) { return true; });
+    if (!line.has_value()) {
+        return std::nullopt;
+    }
+    return board[*line];
+}
+
+/// Returns true iff `player` has `line_length` marks aligned horizontally, vertically or diagonally
+template<int line_length, int width, int height, typename Player>
+bool has_aligned(const BoardT<width, height, Player>& board, Player player)
+{
+    return find_line<line_length>(board, [&](Player mark) { return mark == player; }).has_value();
+}
+
+/// Placement policy: a mark can be placed in any empty cell, like in Noughts and Crosses
+struct PlaceAnywhere {
+    /// Returns the cell that receives the mark when a player chooses `cell`, or std::nullopt if that move is not allowed
+    template<int width, int height, typename Player>
+    static std::optional<CellIndex> landing_cell(const BoardT<width, height, Player>& board, CellIndex cell)
+    {
+        if (board[cell].has_value()) {
+            return std::nullopt;
+        }
+        return std::make_optional(cell);
+    }
+
+    template<int width, int height, typename Player>
+    static int moves_count(const BoardT<width, height, Player>& board)
+    {
+        return static_cast<int>(std::count_if(board.begin(), board.end(), [](const auto& cell) {
+            return !cell.has_value();
+        }));
+    }
+
+    // Positions are indexed by reading the board as a number in base 3, one digit per cell:
+    // 0 for an empty cell, 1 for a mark of the first player and 2 for the second player.
+
+    template<int width, int height>
+    static constexpr uint64_t positions_count()
+    {
+        uint64_t count = 1;
+        for (int cell = 0; cell < width * height; ++cell) {
+            count *= 3;
+        }
+        return count;
+    }
+
+    template<int width, int height, typename Player>
+    static uint64_t index_of(const BoardT<width, height, Player>& board, Player first_player)
+    {
+        uint64_t index = 0;
+        uint64_t power = 1;
+        for (const auto& cell : board) {
+            if (cell.has_value()) {
+                index += (*cell == first_player ? 1 : 2) * power;
+            }
+            power *= 3;
+        }
+        return index;
+    }
+
+    template<int width, int height>
+    static BoardT<width, height, Side> board_at(uint64_t index)
+    {
+        auto board = BoardT<width, height, Side>{};
+        for (auto& cell : board) {
+            const auto digit = index % 3;
+            index /= 3;
+            if (digit == 1) {
+                cell = Side::First;
+            }
+            else if (digit == 2) {
+                cell = Side::Second;
+            }
+        }
+        return board;
+    }
+
+    /// Calls `callback` with the index of each board where one of the marks of `side` has not been placed yet
+    template<int width, int height, typename Callback>
+    static void for_each_predecessor(const BoardT<width, height, Side>& board, uint64_t index, Side side, Callback&& callback)
+    {
+        const uint64_t digit = side == Side::First ? 1 : 2;
+        uint64_t       power = 1;
+        for (const auto& cell : board) {
+            if (cell == side) {
+                callback(index - digit * power);
+            }
+            power *= 3;
+        }
+    }
+};
+
+/// Placement policy: a mark placed in a column falls to the lowest empty cell, like in Connect 4
+struct DropInColumn {
+    template<int width, int height, typename Player>
+    static std::optional<CellIndex> landing_cell(const BoardT<width, height, Player>& board, CellIndex cell)
+    {
+        for (int y = 0; y < height; ++y) {
+            if (!board[{cell.x, y}].has_value()) {
+                return std::make_optional(CellIndex{cell.x, y});
+            }
+        }
+        return std::nullopt;
+    }
+
+    template<int width, int height, typename Player>
+    static int moves_count(const BoardT<width, height, Player>& board)
+    {
+        int count = 0;
+        for (int x = 0; x < width; ++x) {
+            if (!board[{x, height - 1}].has_value()) {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    // Since there are no holes in a column, a column with n marks is indexed by 2^n - 1 (the number of columns with fewer marks)
+    // plus one bit per mark (0 for the first player and 1 for the second one).
+    // A board is then a number whose digits are its columns. This indexes a lot fewer boards than PlaceAnywhere's indexing,
+    // which would waste most of its indices on boards with floating marks.
+
+    template<int height>
+    static constexpr uint64_t column_states_count() { return (uint64_t{1} << (height + 1)) - 1; }
+
+    template<int width, int height>
+    static constexpr uint64_t positions_count()
+    {
+        uint64_t count = 1;
+        for (int x = 0; x < width; ++x) {
+            count *= column_states_count<height>();
+        }
+        return count;
+    }
+
+    template<int width, int height, typename Player>
+    static uint64_t index_of(const BoardT<width, height, Player>& board, Player first_player)
+    {
+        uint64_t index = 0;
+        uint64_t power = 1;
+        for (int x = 0; x < width; ++x) {
+            int      marks_count = 0;
+            uint64_t marks       = 0;
+            while (marks_count < height && board[{x, marks_count}].has_value()) {
+                if (*board[{x, marks_count}] != first_player) {
+                    marks |= uint64_t{1} << marks_count;
+                }
+                marks_count++;
+            }
+            index += ((uint64_t{1} << marks_count) - 1 + marks) * power;
+            power *= column_states_count<height>();
+        }
+        return index;
+    }
+
+    template<int width, int height>
+    static BoardT<width, height, Side> board_at(uint64_t index)
+    {
+        auto board = BoardT<width, height, Side>{};
+        for (int x = 0; x < width; ++x) {
+            const auto column_state = index % column_states_count<height>();
+            index /= column_states_count<height>();
+            int marks_count = 0;
+            while ((uint64_t{1} << (marks_count + 1)) - 1 <= column_state) {
+                marks_count++;
+            }
+            const auto marks = column_state - ((uint64_t{1} << marks_count) - 1);
+            for (int y = 0; y < marks_count; ++y) {
+                board[{x, y}] = (marks & (uint64_t{1} << y)) ? Side::Second : Side::First;
+            }
+        }
+        return board;
+    }
+
+    /// Calls `callback` with the index of each board where the mark on top of one of the columns, which must be a mark of `side`, has not been placed yet
+    template<int width, int height, typename Callback>
+    static void for_each_predecessor(const BoardT<width, height, Side>& board, uint64_t index, Side side, Callback&& callback)
+    {
+        uint64_t power = 1;
+        for (int x = 0; x < width; ++x) {
+            int marks_count = 0;
+            while (marks_count < height && board[{x, marks_count}].has_value()) {
+                marks_count++;
+            }
+            if (marks_count > 0 && board[{x, marks_count - 1}] == side) {
+                // Removing the top mark removes 2^(n-1) from the "2^n - 1" part, and its own bit if it belongs to the second player
+                const uint64_t top_bit = side == Side::Second ? uint64_t{1} << (marks_count - 1) : 0;
+                callback(index - ((uint64_t{1} << (marks_count - 1)) + top_bit) * power);
+            }
+            power *= column_states_count<height>();
+        }
+    }
+};
+
+/// Ending policy: the first player to align wins
+struct NormalPlay {
+    static constexpr bool aligning_wins = true;
+};
+
+/// Ending policy: the first player to align loses
+struct Misere {
+    static constexpr bool aligning_wins = false;
+};
+
+template<int width_, int height_, int line_length_, typename Placement = PlaceAnywhere, typename Ending = NormalPlay>
+struct Rules {
+    static constexpr int width       = width_;
+    static constexpr int height      = height_;
+    static constexpr int line_length = line_length_;
+    using PlacementPolicy            = Placement;
+    using EndingPolicy               = Ending;
+
+    template<typename Player>
+    using Board = BoardT<width, height, Player>;
+
+    /// Returns the cell that receives the mark when a player chooses `cell`, or std::nullopt if that move is not allowed
+    template<typename Player>
+    static std::optional<CellIndex> landing_cell(const Board<Player>& board, CellIndex cell)
+    {
+        return Placement::landing_cell(board, cell);
+    }
+
+    /// Returns the player who has won, if any. `player` and `opponent` are the two players of the game.
+    template<typename Player>
+    static std::optional<Player> winner(const Board<Player>& board, Player player, Player opponent)
+    {
+        const auto aligned = player_who_aligned<line_length>(board);
+        if (!aligned.has_value() || Ending::aligning_wins) {
+            return aligned;
+        }
+        return *aligned == player ? opponent : player;
+    }
+};
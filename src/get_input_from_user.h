@@ -1,15 +1,28 @@
 #pragma once
+#include <cstdlib>
 #include <iostream>
+#include "input_source.h"
+#include "session.h"
 
-/// Blocks until the user inputs something of type T in the console
+/// Blocks until the user inputs something of type T in the console (or reads it from the session that is being replayed, or from a script)
+/// Each input is on its own line, and the blank lines are skipped. The input is written to the log of the session.
+/// Quits the program once there is nothing left to read.
 template<typename T>
 T get_input_from_user()
 {
-    T input; // NOLINT
-    while (!(std::cin >> input)) {
-        std::cin.clear();                                                   // The user did not input a valid T so we need
-        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // to clear cin and try again
+    auto& user_input = session_input();
+    while (true) {
+        const auto line = user_input.next_line();
+        if (!line.has_value()) {
+            std::exit(0); // NOLINT(concurrency-mt-unsafe)
+        }
+        if (is_blank(*line)) {
+            continue;
+        }
+        if (const auto input = parse_input<T>(*line); input.has_value()) {
+            session_log() << *input << std::endl; // Flushed so that the log is complete even if the program crashes
+            return *input;
+        }
         std::cout << "Invalid input, try again!\n";
     }
-    return input;
 }
\ No newline at end of file
@@ -2,40 +2,63 @@
 #include <array>
 #include <cassert>
 #include <iostream>
-#include "get_input_from_user.h"
+#include "dawg.h"
+#include "options.h"
 #include "rand.h"
+#include "word_stream.h"
+#include "word_with_missing_letters.h"
 #include <algorithm>
 
-class WordWithMissingLetters {
-public:
-    WordWithMissingLetters(std::string_view word)
-        : _word{word}
-        , _letters_revealed(word.size(), false)
-    {
-    }
-
-    void mark_as_guessed(char guessed_letter) // mark_as_guessed is the only function in our hangman program that needs mutable access to the private variables.
-    {                                         // And actually it only needs to index into _letters_revealed so we could even have mark_as_guessed() as a free function if we added methods to get _letters_revealed.begin() and _letters_revealed.end()
-        std::transform(_letters_revealed.begin(), _letters_revealed.end(), _word.begin(), _letters_revealed.begin(), [&](bool b, char letter) {
-            if (guessed_letter == letter) {
-                return true;
-            }
-            else {
-                return b;
-            }
-        });
-    }
-
-    const std::string&       word() const { return _word; }                        // We add getters but no setters: people can see the values but not modify them
-    const std::vector<bool>& letters_guessed() const { return _letters_revealed; } // because we don't want anybody to be able to mess up our invariant
+const std::optional<Dictionary>& hangman_dictionary()
+{
+    static const auto dictionary = []() -> std::optional<Dictionary> {
+        const auto path = option("dictionary");
+        if (!path.has_value()) {
+            return std::nullopt;
+        }
+        auto dictionary = Dictionary::open(*path);
+        if (!dictionary.has_value() || dictionary->words_count() == 0) {
+            std::cout << "Could not read any word from \"" << *path << "\", using the default words instead\n";
+            return std::nullopt;
+        }
+        return dictionary;
+    }();
+    return dictionary;
+}
 
-private:
-    std::string       _word;
-    std::vector<bool> _letters_revealed;
-};
+/// The dictionary given with `--dawg <file>` on the command line, if any. It is read directly from the file, without loading the words.
+static const std::optional<Dawg>& hangman_dawg()
+{
+    static const auto dawg = []() -> std::optional<Dawg> {
+        const auto path = option("dawg");
+        if (!path.has_value()) {
+            return std::nullopt;
+        }
+        auto dawg = Dawg::open(*path);
+        if (!dawg.has_value() || dawg->words_count() == 0) {
+            std::cout << "Could not read any word from \"" << *path << "\", using the default words instead\n";
+            return std::nullopt;
+        }
+        return dawg;
+    }();
+    return dawg;
+}
 
-const char* pick_a_random_word()
+std::string pick_a_random_word()
 {
+    if (const auto path = option("stream-dictionary"); path.has_value()) { // Read again for each game, so that the file never has to fit in memory
+        if (auto word = pick_a_random_word_in_file(*path, word_filter_from_options()); word.has_value()) {
+            return std::move(*word);
+        }
+        std::cout << "Could not find any word that matches the filter in \"" << *path << "\", using the default words instead\n";
+    }
+    if (const auto& dawg = hangman_dawg(); dawg.has_value()) {
+        return dawg->random_word();
+    }
+    if (const auto& dictionary = hangman_dictionary(); dictionary.has_value()) {
+        return std::string{dictionary->random_word()};
+    }
+
     static constexpr std::array words = {
         "code",
         "crous",
@@ -43,12 +66,12 @@ const char* pick_a_random_word()
         "opengl",
     };
 
-    return words[rand<size_t>(0, words.size() - 1)];
+    return std::string{words[rand<size_t>(0, words.size() - 1)]};
 }
 
-void show_number_of_lives(int number_of_lives)
+void show_number_of_lives(Screen& screen, int number_of_lives)
 {
-    std::cout << "You have " << number_of_lives << " lives\n";
+    screen << "You have " << number_of_lives << " lives\n";
 }
 
 bool player_is_alive(int number_of_lives)
@@ -56,30 +79,23 @@ bool player_is_alive(int number_of_lives)
     return number_of_lives > 0;
 }
 
-bool player_has_won(const std::vector<bool>& letters_guessed)
+bool player_has_won(const WordWithMissingLetters& word)
 {
-    return std::all_of(letters_guessed.begin(), letters_guessed.end(), [](bool letter_guessed) {
-        return letter_guessed;
-    });
+    return word.is_fully_revealed();
 }
 
-void show_word_to_guess_with_missing_letters(const WordWithMissingLetters& word)
+void show_word_to_guess_with_missing_letters(Screen& screen, const WordWithMissingLetters& word)
 {
-    for (size_t i = 0; i < word.word().size(); ++i) { // Unfortunately we have to use a raw loop to index into both word and letters_guessed. In C++23 we will be able to use zip instead which is amazing! The loop would then look like `for (const auto& [letter, has_been_guessed] : zip(word, letters_guessed))`
-        if (word.letters_guessed()[i]) {
-            std::cout << word.word()[i];
+    for (size_t i = 0; i < word.word().size(); ++i) { // Unfortunately we have to use a raw loop to index into both the word and the letters that are revealed. In C++23 we will be able to use zip instead which is amazing! The loop would then look like `for (const auto& [letter, is_revealed] : zip(word, revealed_letters))`
+        if (word.is_revealed(i)) {
+            screen << word.word()[i];
         }
         else {
-            std::cout << '_';
+            screen << '_';
         }
-        std::cout << ' ';
+        screen << ' ';
     }
-    std::cout << '\n';
-}
-
-bool word_contains(char letter, std::string_view word)
-{
-    return word.find(letter) != std::string_view::npos;
+    screen << '\n';
 }
 
 void remove_one_life(int& lives_count)
@@ -87,35 +103,43 @@ void remove_one_life(int& lives_count)
     lives_count--;
 }
 
-void show_congrats_message(std::string_view word_to_guess)
+void show_congrats_message(Screen& screen, std::string_view word_to_guess)
 {
-    std::cout << "Congrats, you won!\nThe word was \"" << word_to_guess << "\"\n";
+    screen << "Congrats, you won!\nThe word was \"" << word_to_guess << "\"\n";
 }
 
-void show_defeat_message(std::string_view word_to_guess)
+void show_defeat_message(Screen& screen, std::string_view word_to_guess)
 {
-    std::cout << "Sorry, you lost!\nThe word was \"" << word_to_guess << "\"\n";
+    screen << "Sorry, you lost!\nThe word was \"" << word_to_guess << "\"\n";
 }
 
-void play_hangman()
+GameTask hangman_game(SessionInputs& inputs, Screen& screen)
 {
     WordWithMissingLetters word{pick_a_random_word()};
-    int                    number_of_lives = 8;
-    while (player_is_alive(number_of_lives) && !player_has_won(word.letters_guessed())) {
-        show_number_of_lives(number_of_lives);
-        show_word_to_guess_with_missing_letters(word);
-        const auto guess = get_input_from_user<char>();
-        if (word_contains(guess, word.word())) {
+    int                    number_of_lives = hangman_lives_count;
+    while (player_is_alive(number_of_lives) && !player_has_won(word)) {
+        show_number_of_lives(screen, number_of_lives);
+        show_word_to_guess_with_missing_letters(screen, word);
+        const auto guess = co_await inputs.next<char>();
+        if (word.contains(guess)) {
             word.mark_as_guessed(guess);
         }
         else {
             remove_one_life(number_of_lives);
         }
     }
-    if (player_has_won(word.letters_guessed())) {
-        show_congrats_message(word.word());
+    if (player_has_won(word)) {
+        show_congrats_message(screen, word.word());
     }
     else {
-        show_defeat_message(word.word());
+        show_defeat_message(screen, word.word());
     }
+}
+
+void play_hangman()
+{
+    auto       inputs = SessionInputs{};
+    auto       screen = Screen{};
+    const auto game   = hangman_game(inputs, screen);
+    play_until_over(game, inputs, screen);
 }
\ No newline at end of file
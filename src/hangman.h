@@ -1,3 +1,24 @@
 #pragma once
+#include <optional>
+#include <string_view>
+#include "dictionary.h"
+#include "game_coroutine.h"
+#include "screen.h"
 
-void play_hangman();
\ No newline at end of file
+/// How many wrong guesses the player can make before losing
+inline constexpr int hangman_lives_count = 8;
+
+/// The dictionary given with `--dictionary <file>` on the command line, if any
+const std::optional<Dictionary>& hangman_dictionary();
+
+/// A game of hangman, that waits for the guesses in `inputs` and shows its state on `screen`, which must live until the game is destroyed
+GameTask hangman_game(SessionInputs& inputs, Screen& screen);
+
+void play_hangman();
+
+// Shared with the other versions of hangman
+void show_number_of_lives(Screen& screen, int number_of_lives);
+bool player_is_alive(int number_of_lives);
+void remove_one_life(int& lives_count);
+void show_congrats_message(Screen& screen, std::string_view word_to_guess);
+void show_defeat_message(Screen& screen, std::string_view word_to_guess);
\ No newline at end of file
@@ -0,0 +1,277 @@
+#include "hangman_decision_tree.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include "hangman.h"
+#include "hangman_solver.h"
+#include "input_source.h"
+#include "word_with_missing_letters.h"
+
+struct DecisionTreeNode {
+    uint32_t first_child;
+    uint32_t children_count_and_guess; // The number of children (24 bits) and the letter to guess (8 bits, 0 when there is nothing left to guess)
+};
+
+/// The file starts with this header, then contains the positions of all the children, the nodes, the nodes of all the children and the roots.
+/// The arrays of 64 bit values come first so that they are aligned.
+struct DecisionTreeHeader {
+    std::array<char, 8> magic_number;
+    uint64_t            max_length;
+    uint64_t            nodes_count;
+    uint64_t            children_count;
+};
+
+static constexpr std::array<char, 8> decision_tree_magic_number = {'H', 'M', 'T', 'R', 'E', 'E', '0', '1'};
+static constexpr uint32_t            no_root                    = UINT32_MAX;
+
+std::optional<HangmanDecisionTree> HangmanDecisionTree::open(const std::filesystem::path& path)
+{
+    auto file = MemoryMappedFile::open(path);
+    if (!file.has_value() || file->size() < sizeof(DecisionTreeHeader)) {
+        return std::nullopt;
+    }
+    auto header = DecisionTreeHeader{};
+    std::memcpy(&header, file->data(), sizeof(header));
+    const auto expected_size = sizeof(DecisionTreeHeader) + header.children_count * (sizeof(uint64_t) + sizeof(uint32_t))
+                               + header.nodes_count * sizeof(DecisionTreeNode) + (header.max_length + 1) * sizeof(uint32_t);
+    if (header.magic_number != decision_tree_magic_number || file->size() != expected_size) {
+        return std::nullopt;
+    }
+    return std::make_optional(HangmanDecisionTree{std::move(*file)});
+}
+
+HangmanDecisionTree::HangmanDecisionTree(MemoryMappedFile file)
+    : _file{std::move(file)}
+{
+    auto header = DecisionTreeHeader{};
+    std::memcpy(&header, _file.data(), sizeof(header));
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+    _children_positions = reinterpret_cast<const uint64_t*>(_file.data() + sizeof(DecisionTreeHeader));
+    _nodes              = reinterpret_cast<const DecisionTreeNode*>(_children_positions + header.children_count);
+    _children_nodes     = reinterpret_cast<const uint32_t*>(_nodes + header.nodes_count);
+    _roots              = _children_nodes + header.children_count;
+    _max_length         = header.max_length;
+    // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+}
+
+std::optional<uint32_t> HangmanDecisionTree::root(size_t length) const
+{
+    if (length > _max_length || _roots[length] == no_root) {
+        return std::nullopt;
+    }
+    return _roots[length];
+}
+
+std::optional<char> HangmanDecisionTree::guess(uint32_t node) const
+{
+    const auto guess = static_cast<char>(_nodes[node].children_count_and_guess & 0xFF);
+    if (guess == 0) {
+        return std::nullopt;
+    }
+    return guess;
+}
+
+std::optional<uint32_t> HangmanDecisionTree::next_node(uint32_t node, uint64_t positions) const
+{
+    // A node has a few dozens of children at most, so a binary search in them only reads one or two cache lines
+    const auto* begin = _children_positions + _nodes[node].first_child;
+    const auto* end   = begin + (_nodes[node].children_count_and_guess >> 8);
+    const auto* child = std::lower_bound(begin, end, positions);
+    if (child == end || *child != positions) {
+        return std::nullopt;
+    }
+    return _children_nodes[child - _children_positions];
+}
+
+/// The nodes of a tree, or of a part of it, while it is being built
+/// The children of each node are next to each other in `children_positions` and `children_nodes`.
+struct DecisionTreeNodes {
+    std::vector<DecisionTreeNode> nodes;
+    std::vector<uint64_t>         children_positions;
+    std::vector<uint32_t>         children_nodes;
+};
+
+/// Adds the node of the game state of `solver`, and all the nodes that can come after it. Returns the index of the node.
+static uint32_t add_subtree(HangmanSolver& solver, DecisionTreeNodes& tree)
+{
+    const auto node  = static_cast<uint32_t>(tree.nodes.size());
+    const auto guess = solver.next_guess();
+    tree.nodes.push_back({static_cast<uint32_t>(tree.children_positions.size()), 0});
+    if (!guess.has_value()) {
+        return node;
+    }
+    auto       children    = solver.solvers_after_guess(*guess);
+    const auto first_child = tree.children_positions.size();
+    tree.nodes[node].children_count_and_guess = static_cast<uint32_t>(children.size() << 8) | static_cast<uint8_t>(*guess);
+    tree.children_positions.resize(first_child + children.size());
+    tree.children_nodes.resize(first_child + children.size());
+    for (size_t i = 0; i < children.size(); ++i) {
+        tree.children_positions[first_child + i] = children[i].first;
+        tree.children_nodes[first_child + i]     = add_subtree(children[i].second, tree);
+    }
+    return node;
+}
+
+/// A part of the tree that one thread builds on its own
+struct SubtreeTask {
+    HangmanSolver     solver;
+    size_t            parent_child; // Where the index of the root of the subtree goes in the children of its parent
+    DecisionTreeNodes nodes;
+};
+
+static bool save_decision_tree(const DecisionTreeNodes& tree, const std::vector<uint32_t>& roots, const std::filesystem::path& path)
+{
+    auto file = std::ofstream{path, std::ios::binary};
+    if (!file) {
+        return false;
+    }
+    const auto header = DecisionTreeHeader{decision_tree_magic_number, roots.size() - 1, tree.nodes.size(), tree.children_positions.size()};
+    const auto write  = [&](const auto* data, size_t count) {
+        file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(count * sizeof(*data))); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    };
+    write(&header, 1);
+    write(tree.children_positions.data(), tree.children_positions.size());
+    write(tree.nodes.data(), tree.nodes.size());
+    write(tree.children_nodes.data(), tree.children_nodes.size());
+    write(roots.data(), roots.size());
+    return static_cast<bool>(file);
+}
+
+int build_hangman_decision_tree(const std::vector<std::string_view>& arguments)
+{
+    static constexpr std::string_view usage      = "--dictionary <file> build-hangman-tree <output file> [number of threads]";
+    const auto                        dictionary = open_dictionary_option(usage);
+    if (!dictionary.has_value()) {
+        return 1;
+    }
+    const auto threads_count_argument = arguments.size() > 1 ? parse_input<unsigned int>(arguments[1]) : std::max(1u, std::thread::hardware_concurrency());
+    if (arguments.empty() || threads_count_argument.value_or(0) == 0) {
+        std::cout << "Usage: " << usage << "\nThe number of threads must be positive\n";
+        return 1;
+    }
+    const auto path          = std::filesystem::path{arguments[0]};
+    const auto threads_count = *threads_count_argument;
+
+    // The roots are built first, and the subtrees of their children are spread over the threads.
+    // Each thread builds its subtrees with their own numbering, and they are appended to the tree at the end.
+    const auto begin = std::chrono::steady_clock::now();
+    auto       tree  = DecisionTreeNodes{};
+    auto       roots = std::vector<uint32_t>(dictionary->max_length() + 1, no_root);
+    auto       tasks = std::vector<SubtreeTask>{};
+    for (size_t length = 1; length <= dictionary->max_length(); ++length) {
+        if (dictionary->words_with_length(length).empty()) {
+            continue;
+        }
+        auto       solver = HangmanSolver{dictionary->words_with_length(length)};
+        const auto guess  = solver.next_guess();
+        roots[length]     = static_cast<uint32_t>(tree.nodes.size());
+        tree.nodes.push_back({static_cast<uint32_t>(tree.children_positions.size()), 0});
+        if (!guess.has_value()) {
+            continue;
+        }
+        auto children = solver.solvers_after_guess(*guess);
+        tree.nodes.back().children_count_and_guess = static_cast<uint32_t>(children.size() << 8) | static_cast<uint8_t>(*guess);
+        for (auto& [positions, child] : children) {
+            tasks.push_back({std::move(child), tree.children_positions.size(), {}});
+            tree.children_positions.push_back(positions);
+            tree.children_nodes.push_back(0);
+        }
+    }
+    // The biggest subtrees go first, so that no thread is left with a big one at the end while the other ones wait
+    std::sort(tasks.begin(), tasks.end(), [](const SubtreeTask& a, const SubtreeTask& b) {
+        return a.solver.possible_words_count() > b.solver.possible_words_count();
+    });
+    auto next_task = std::atomic<size_t>{0};
+    auto threads   = std::vector<std::thread>{};
+    for (unsigned int thread = 0; thread < threads_count; ++thread) {
+        threads.emplace_back([&]() {
+            for (size_t task = next_task++; task < tasks.size(); task = next_task++) {
+                add_subtree(tasks[task].solver, tasks[task].nodes);
+                tasks[task].solver = HangmanSolver{std::vector<std::string_view>{}}; // Frees its words
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto& task : tasks) {
+        const auto nodes_offset    = static_cast<uint32_t>(tree.nodes.size());
+        const auto children_offset = static_cast<uint32_t>(tree.children_positions.size());
+        tree.children_nodes[task.parent_child] = nodes_offset;
+        for (auto node : task.nodes.nodes) {
+            node.first_child += children_offset;
+            tree.nodes.push_back(node);
+        }
+        tree.children_positions.insert(tree.children_positions.end(), task.nodes.children_positions.begin(), task.nodes.children_positions.end());
+        for (const auto child : task.nodes.children_nodes) {
+            tree.children_nodes.push_back(child + nodes_offset);
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    if (!save_decision_tree(tree, roots, path)) {
+        std::cout << "Could not write \"" << path.string() << "\"\n";
+        return 1;
+    }
+    std::cout << "Built in " << std::chrono::duration<double>{end - begin}.count() << "s with " << threads_count << " threads: "
+              << tree.nodes.size() << " nodes in " << std::filesystem::file_size(path) << " bytes\n";
+    return 0;
+}
+
+int play_hangman_with_decision_tree(const std::vector<std::string_view>& arguments)
+{
+    const auto dictionary = open_dictionary_option("--dictionary <file> hangman-tree-bot <decision tree file>");
+    if (!dictionary.has_value()) {
+        return 1;
+    }
+    if (arguments.empty()) {
+        std::cout << "Usage: --dictionary <file> hangman-tree-bot <decision tree file>\n";
+        return 1;
+    }
+    const auto tree = HangmanDecisionTree::open(arguments[0]);
+    if (!tree.has_value()) {
+        std::cout << "Could not read a decision tree from \"" << arguments[0] << "\"\n";
+        return 1;
+    }
+
+    size_t     games_count   = 0;
+    size_t     wins_count    = 0;
+    size_t     guesses_count = 0;
+    const auto begin         = std::chrono::steady_clock::now();
+    for (size_t length = 1; length <= dictionary->max_length(); ++length) {
+        for (const auto word_to_guess : dictionary->words_with_length(length)) {
+            auto word            = WordWithMissingLetters{word_to_guess};
+            auto node            = tree->root(length);
+            int  number_of_lives = hangman_lives_count;
+            while (node.has_value() && player_is_alive(number_of_lives) && !word.is_fully_revealed()) {
+                const auto guess = tree->guess(*node);
+                if (!guess.has_value()) {
+                    break;
+                }
+                guesses_count++;
+                if (word.contains(*guess)) {
+                    word.mark_as_guessed(*guess);
+                }
+                else {
+                    number_of_lives--;
+                }
+                node = tree->next_node(*node, word.positions_of(*guess));
+            }
+            games_count++;
+            if (word.is_fully_revealed()) {
+                wins_count++;
+            }
+        }
+    }
+    const auto seconds = std::chrono::duration<double>{std::chrono::steady_clock::now() - begin}.count();
+
+    std::cout << "Played " << games_count << " words in " << seconds << "s: " << static_cast<double>(games_count) / seconds << " words per second, "
+              << static_cast<double>(guesses_count) / seconds << " guesses per second\n"
+              << "Won " << 100. * static_cast<double>(wins_count) / static_cast<double>(games_count) << "% of the games with " << hangman_lives_count << " lives\n";
+    return 0;
+}
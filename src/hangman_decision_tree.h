@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <vector>
+#include "memory_mapped_file.h"
+
+struct DecisionTreeNode;
+
+/// What HangmanSolver would guess in every game it can play with a given dictionary, computed once and saved to a file
+/// Each node is a state of a game: it knows the letter to guess, and the node we get to for each result of that guess.
+/// The file is memory-mapped and used as is, so that a bot only has to follow the nodes instead of looking at the possible words.
+class HangmanDecisionTree {
+public:
+    /// Returns std::nullopt if the file doesn't exist or is not a decision tree file
+    static std::optional<HangmanDecisionTree> open(const std::filesystem::path& path);
+
+    /// The node where the games start for the words that have `length` letters,
+    /// or std::nullopt if the dictionary didn't have any word of that length
+    std::optional<uint32_t> root(size_t length) const;
+
+    /// The letter to guess, or std::nullopt if all the letters of the possible words have been guessed
+    std::optional<char> guess(uint32_t node) const;
+
+    /// The node we get to when guess(node) is at `positions` (one bit per position, 0 for a miss),
+    /// or std::nullopt if no word of the dictionary has it there
+    std::optional<uint32_t> next_node(uint32_t node, uint64_t positions) const;
+
+private:
+    explicit HangmanDecisionTree(MemoryMappedFile file);
+
+private:
+    MemoryMappedFile        _file;
+    const uint64_t*         _children_positions; // The results of the guess of each node, sorted, starting at DecisionTreeNode::first_child
+    const DecisionTreeNode* _nodes;
+    const uint32_t*         _children_nodes; // The node that each result leads to
+    const uint32_t*         _roots;          // Indexed by the length of the words
+    size_t                  _max_length;
+};
+
+/// Builds the decision tree of the dictionary given with `--dictionary <file>` on several threads, and saves it to the file given in `arguments`
+/// The number of threads can be given after the file (one per core by default).
+int build_hangman_decision_tree(const std::vector<std::string_view>& arguments);
+
+/// Lets a bot that follows the decision tree given in `arguments` play hangman, with the usual number of lives,
+/// for every word of the dictionary given with `--dictionary <file>`, and shows how fast it is and how often it wins
+int play_hangman_with_decision_tree(const std::vector<std::string_view>& arguments);
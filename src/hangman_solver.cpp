@@ -0,0 +1,306 @@
+#include "hangman_solver.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <string>
+#include <thread>
+#include "hangman.h"
+#include "input_source.h"
+#include "options.h"
+
+HangmanSolver::HangmanSolver(const std::vector<std::string_view>& words)
+    : _word_length{words.empty() ? 0 : words.front().size()}
+{
+    _candidates.reserve(words.size());
+    for (const auto word : words) {
+        _candidates.push_back({word.data(), letters_of(word)});
+    }
+}
+
+std::optional<char> HangmanSolver::next_guess()
+{
+    if (_next_guess_is_known) {
+        return _next_guess;
+    }
+    // A letter splits the possible words into groups that have it at the same positions (the words that don't have it being one of the groups).
+    // The expected information is log2(N) - sum(n * log2(n)) / N, where N is the number of words and n the size of each group,
+    // so the best letter is the one with the smallest sum(n * log2(n)).
+    const auto weight = [](size_t group_size) {
+        return static_cast<double>(group_size) * std::log2(static_cast<double>(group_size));
+    };
+    for (auto& patterns : _patterns) {
+        patterns.clear();
+    }
+    for (const auto& candidate : _candidates) { // A single pass over each word finds the positions of all its letters
+        auto positions = std::array<uint64_t, 26>{};
+        for (size_t i = 0; i < _word_length; ++i) {
+            positions[static_cast<size_t>(candidate.word[i] - 'a')] |= uint64_t{1} << i;
+        }
+        const auto letters = candidate.letters & ~_letters_guessed;
+        for (size_t letter = 0; letter < positions.size(); ++letter) {
+            if (letters & (LetterMask{1} << letter)) { // Only the letters that the word contains matter
+                _patterns[letter].push_back(positions[letter]);
+            }
+        }
+    }
+    auto best_letter = std::optional<char>{};
+    auto best_weight = 0.;
+    for (size_t letter = 0; letter < _patterns.size(); ++letter) {
+        auto& patterns = _patterns[letter];
+        if (patterns.empty()) { // Either we already guessed it, or we know that it is a miss, so it doesn't tell us anything
+            continue;
+        }
+        std::sort(patterns.begin(), patterns.end());
+        auto letter_weight = patterns.size() < _candidates.size() ? weight(_candidates.size() - patterns.size()) : 0.;
+        for (size_t group_begin = 0; group_begin < patterns.size();) {
+            size_t group_end = group_begin + 1;
+            while (group_end < patterns.size() && patterns[group_end] == patterns[group_begin]) {
+                group_end++;
+            }
+            letter_weight += weight(group_end - group_begin);
+            group_begin = group_end;
+        }
+        if (!best_letter.has_value() || letter_weight < best_weight) {
+            best_letter = static_cast<char>('a' + letter);
+            best_weight = letter_weight;
+        }
+    }
+    for (auto& patterns : _patterns) { // So that the copies of the solver don't copy them
+        patterns.clear();
+    }
+    _next_guess          = best_letter;
+    _next_guess_is_known = true;
+    return best_letter;
+}
+
+void HangmanSolver::on_guess_result(char letter, uint64_t positions)
+{
+    const auto bit = letter_bit(letter);
+    _letters_guessed |= bit;
+    _next_guess_is_known = false;
+    if (positions == 0) {
+        _candidates.erase(std::remove_if(_candidates.begin(), _candidates.end(), [&](const Candidate& candidate) {
+                              return candidate.letters & bit;
+                          }),
+                          _candidates.end());
+    }
+    else {
+        _candidates.erase(std::remove_if(_candidates.begin(), _candidates.end(), [&](const Candidate& candidate) {
+                              return !(candidate.letters & bit) || positions_of(letter, {candidate.word, _word_length}) != positions;
+                          }),
+                          _candidates.end());
+    }
+}
+
+std::vector<std::pair<uint64_t, HangmanSolver>> HangmanSolver::solvers_after_guess(char letter) const
+{
+    const auto bit        = letter_bit(letter);
+    auto       candidates = std::vector<std::pair<uint64_t, Candidate>>{};
+    candidates.reserve(_candidates.size());
+    for (const auto& candidate : _candidates) {
+        candidates.emplace_back((candidate.letters & bit) ? positions_of(letter, {candidate.word, _word_length}) : 0, candidate);
+    }
+    std::stable_sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+
+    auto solvers = std::vector<std::pair<uint64_t, HangmanSolver>>{};
+    for (const auto& [positions, candidate] : candidates) {
+        if (solvers.empty() || solvers.back().first != positions) {
+            auto& solver            = solvers.emplace_back(positions, HangmanSolver{}).second;
+            solver._word_length     = _word_length;
+            solver._letters_guessed = _letters_guessed | bit;
+        }
+        solvers.back().second._candidates.push_back(candidate);
+    }
+    return solvers;
+}
+
+struct SolverStatistics {
+    int games_count{0};
+    int guesses_count{0};
+    int misses_count{0};
+    int max_misses_count{0};
+};
+
+struct GameStatistics {
+    int guesses_count{0};
+    int misses_count{0};
+};
+
+/// Lets `solver` guess `word_to_guess` until it has found all its letters, or until it has missed `max_misses_count` times
+GameStatistics let_solver_guess(HangmanSolver solver, std::string_view word_to_guess, int max_misses_count = std::numeric_limits<int>::max())
+{
+    auto word       = WordWithMissingLetters{word_to_guess};
+    auto statistics = GameStatistics{};
+    while (!word.is_fully_revealed() && statistics.misses_count < max_misses_count) {
+        const auto guess = solver.next_guess();
+        if (!guess.has_value()) { // Can't happen since the word is in the dictionary
+            break;
+        }
+        statistics.guesses_count++;
+        if (word.contains(*guess)) {
+            word.mark_as_guessed(*guess);
+            solver.on_guess_result(*guess, word.positions_of(*guess));
+        }
+        else {
+            statistics.misses_count++;
+            solver.on_guess_result(*guess, 0);
+        }
+    }
+    return statistics;
+}
+
+std::optional<Dictionary> open_dictionary_option(std::string_view usage)
+{
+    const auto path = option("dictionary");
+    if (!path.has_value()) {
+        std::cout << "Usage: " << usage << '\n';
+        return std::nullopt;
+    }
+    auto dictionary = Dictionary::open(*path);
+    if (!dictionary.has_value() || dictionary->words_count() == 0) {
+        std::cout << "Could not read any word from \"" << *path << "\"\n";
+        return std::nullopt;
+    }
+    return dictionary;
+}
+
+/// The solvers that haven't guessed anything yet are the same for all the words of the same length,
+/// so we only build them (and compute their first guess) once
+class InitialSolvers {
+public:
+    explicit InitialSolvers(const Dictionary& dictionary)
+        : _dictionary{dictionary}
+    {
+    }
+
+    const HangmanSolver& for_length(size_t length)
+    {
+        auto solver = _solvers.find(length);
+        if (solver == _solvers.end()) {
+            solver = _solvers.emplace(length, HangmanSolver{_dictionary.words_with_length(length)}).first;
+            solver->second.next_guess();
+        }
+        return solver->second;
+    }
+
+    /// Can be called by several threads at the same time, once for_length() has been called for `length`
+    const HangmanSolver& already_built_for_length(size_t length) const { return _solvers.at(length); }
+
+private:
+    const Dictionary&               _dictionary;
+    std::map<size_t, HangmanSolver> _solvers;
+};
+
+int benchmark_hangman_solver(const std::vector<std::string_view>& arguments)
+{
+    static constexpr std::string_view usage      = "--dictionary <file> hangman-solver [number of words to guess]";
+    const auto                        dictionary = open_dictionary_option(usage);
+    if (!dictionary.has_value()) {
+        return 1;
+    }
+    int games_count = 1000;
+    if (!arguments.empty()) {
+        const auto count = parse_input<int>(arguments[0]);
+        if (!count.has_value() || *count <= 0) {
+            std::cout << "The number of words to guess must be a positive number\nUsage: " << usage << '\n';
+            return 1;
+        }
+        games_count = *count;
+    }
+
+    auto       initial_solvers = InitialSolvers{*dictionary};
+    auto       statistics      = SolverStatistics{};
+    const auto begin           = std::chrono::steady_clock::now();
+    while (statistics.games_count < games_count) {
+        const auto word = dictionary->random_word();
+        const auto game = let_solver_guess(initial_solvers.for_length(word.size()), word);
+        statistics.games_count++;
+        statistics.guesses_count += game.guesses_count;
+        statistics.misses_count += game.misses_count;
+        statistics.max_misses_count = std::max(statistics.max_misses_count, game.misses_count);
+    }
+    const auto seconds = std::chrono::duration<double>{std::chrono::steady_clock::now() - begin}.count();
+
+    std::cout << "Guessed " << statistics.games_count << " words of a dictionary of " << dictionary->words_count() << " words in " << seconds << "s\n"
+              << statistics.guesses_count / seconds << " guesses per second\n"
+              << static_cast<double>(statistics.misses_count) / statistics.games_count << " misses per word on average, "
+              << statistics.max_misses_count << " at most\n";
+    return 0;
+}
+
+int simulate_hangman(const std::vector<std::string_view>& arguments)
+{
+    static constexpr std::string_view usage      = "--dictionary <file> simulate-hangman [number of threads]";
+    const auto                        dictionary = open_dictionary_option(usage);
+    if (!dictionary.has_value()) {
+        return 1;
+    }
+    auto threads_count = std::max(1u, std::thread::hardware_concurrency());
+    if (!arguments.empty()) {
+        const auto count = parse_input<unsigned int>(arguments[0]);
+        if (count.value_or(0) == 0) {
+            std::cout << "The number of threads must be a positive number\nUsage: " << usage << '\n';
+            return 1;
+        }
+        threads_count = *count;
+    }
+
+    const auto begin = std::chrono::steady_clock::now();
+    // Building the initial solvers is only a small part of the work, so it is done before starting the threads, which then only read them
+    auto initial_solvers = InitialSolvers{*dictionary};
+    auto words           = std::vector<std::string_view>{};
+    words.reserve(dictionary->words_count());
+    for (size_t length = 1; length <= dictionary->max_length(); ++length) {
+        if (!dictionary->words_with_length(length).empty()) {
+            initial_solvers.for_length(length);
+            words.insert(words.end(), dictionary->words_with_length(length).begin(), dictionary->words_with_length(length).end());
+        }
+    }
+
+    // Each thread takes the next batch of words until there are none left, so that the threads that get easy words don't wait for the other ones.
+    // The counts are only merged at the end, to avoid sharing anything else than the index of the next batch.
+    static constexpr size_t batch_size = 64;
+    auto                    next_batch = std::atomic<size_t>{0};
+    auto                    misses     = std::vector<std::array<int, hangman_lives_count + 1>>(threads_count); // How many games were won with 0, 1, ... misses, and lost, for each thread
+    auto                    threads    = std::vector<std::thread>{};
+    for (unsigned int thread = 0; thread < threads_count; ++thread) {
+        threads.emplace_back([&, thread]() {
+            auto thread_misses = std::array<int, hangman_lives_count + 1>{}; // Counted on the stack of the thread, since the counts of the threads would share cache lines in `misses`
+            for (size_t batch_begin = next_batch.fetch_add(batch_size); batch_begin < words.size(); batch_begin = next_batch.fetch_add(batch_size)) {
+                const auto batch_end = std::min(batch_begin + batch_size, words.size());
+                for (size_t word = batch_begin; word < batch_end; ++word) {
+                    const auto game = let_solver_guess(initial_solvers.already_built_for_length(words[word].size()), words[word], hangman_lives_count);
+                    thread_misses[static_cast<size_t>(game.misses_count)]++;
+                }
+            }
+            misses[thread] = thread_misses;
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    const auto seconds = std::chrono::duration<double>{std::chrono::steady_clock::now() - begin}.count();
+
+    auto total_misses = std::array<int, hangman_lives_count + 1>{};
+    for (const auto& thread_misses : misses) {
+        for (size_t misses_count = 0; misses_count < total_misses.size(); ++misses_count) {
+            total_misses[misses_count] += thread_misses[misses_count];
+        }
+    }
+    const auto games_count = static_cast<double>(words.size());
+    std::cout << "Played " << words.size() << " words with " << threads_count << " threads in " << seconds << "s: " << games_count / seconds << " words per second\n"
+              << "Won " << 100. * (games_count - total_misses.back()) / games_count << "% of the games with " << hangman_lives_count << " lives\n"
+              << "Misses:\n";
+    for (size_t misses_count = 0; misses_count < total_misses.size(); ++misses_count) {
+        std::cout << "  " << (misses_count == hangman_lives_count ? "lost" : std::to_string(misses_count)) << ": " << total_misses[misses_count]
+                  << " (" << 100. * total_misses[misses_count] / games_count << "%)\n";
+    }
+    return 0;
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "dictionary.h"
+#include "word_with_missing_letters.h"
+
+/// Guesses the letters of a hangman word by keeping track of all the words of a dictionary that are still possible,
+/// and by picking the letter that tells the most about which of them is the word (i.e. that maximises the expected information).
+class HangmanSolver {
+public:
+    /// All the `words` must have the same length as the word to guess, and at most 64 letters
+    explicit HangmanSolver(const std::vector<std::string_view>& words);
+
+    /// Returns the letter that we expect to split the possible words the most evenly,
+    /// or std::nullopt if no possible word has any letter that hasn't been guessed yet
+    std::optional<char> next_guess();
+
+    /// Removes the words that don't have `letter` exactly at `positions` (one bit per position, 0 for a miss)
+    void on_guess_result(char letter, uint64_t positions);
+
+    /// The solvers that we would get with on_guess_result() for each result that guessing `letter` can have, sorted by positions
+    std::vector<std::pair<uint64_t, HangmanSolver>> solvers_after_guess(char letter) const;
+
+    size_t possible_words_count() const { return _candidates.size(); }
+
+private:
+    HangmanSolver() = default;
+
+private:
+    struct Candidate { // Kept small so that filtering the candidates reads as little memory as possible
+        const char* word; // All the words have _word_length letters
+        LetterMask  letters;
+    };
+
+    std::vector<Candidate> _candidates;
+    size_t                 _word_length{0};
+    LetterMask             _letters_guessed{0};
+    std::optional<char>    _next_guess;
+    bool                   _next_guess_is_known{false}; // next_guess() is only computed once per guess, and is copied along with the solver
+    std::array<std::vector<uint64_t>, 26> _patterns; // The positions of each letter in each word. Reused by next_guess() to avoid allocations
+};
+
+/// Opens the dictionary given with `--dictionary <file>`, or shows `usage` or an error message
+std::optional<Dictionary> open_dictionary_option(std::string_view usage);
+
+/// Lets the solver guess words of the dictionary given with `--dictionary <file>`, and shows how fast and how good it is
+/// `arguments` can contain the number of words to guess (1000 by default)
+int benchmark_hangman_solver(const std::vector<std::string_view>& arguments);
+
+/// Lets the solver play hangman, with the usual number of lives, for every word of the dictionary given with `--dictionary <file>`
+/// The words are spread over several threads. `arguments` can contain the number of threads (one per core by default).
+/// Shows the number of words per second, the win rate and how many games were won with each number of misses.
+int simulate_hangman(const std::vector<std::string_view>& arguments);
@@ -0,0 +1,68 @@
+#include "input_reactor.h"
+#include <iostream>
+#include <optional>
+#include "session.h"
+
+void InputReactor::after(std::chrono::milliseconds delay, std::function<void()> on_time)
+{
+    _timers.emplace(Clock::now() + delay, std::move(on_time));
+}
+
+void InputReactor::run()
+{
+    while (!_waiting_sessions.empty()) {
+        const auto now = Clock::now();
+        if (!_timers.empty() && _timers.begin()->first <= now) {
+            auto on_time = std::move(_timers.begin()->second);
+            _timers.erase(_timers.begin());
+            on_time();
+            continue;
+        }
+        // Waits for a line until the next timer
+        auto timeout = std::optional<std::chrono::milliseconds>{};
+        if (!_timers.empty()) {
+            timeout = std::chrono::ceil<std::chrono::milliseconds>(_timers.begin()->first - now);
+        }
+        if (_input.wait_for_line(timeout)) {
+            const auto line = _input.next_line();
+            if (!line.has_value()) {
+                return;
+            }
+            dispatch(*line);
+        }
+    }
+}
+
+void InputReactor::dispatch(std::string_view line)
+{
+    if (is_blank(line)) {
+        return;
+    }
+    session_log() << line << std::endl;
+    // The line starts with the number of its session, unless only one session is waiting
+    auto       waiting_session = _waiting_sessions.end();
+    const auto separator       = line.find(' ');
+    if (const auto session = parse_input<size_t>(line.substr(0, separator)); session.has_value() && separator != std::string_view::npos) {
+        waiting_session = _waiting_sessions.find(*session);
+        if (waiting_session == _waiting_sessions.end()) {
+            std::cout << "Session " << *session << " is not waiting for an input\n";
+            return;
+        }
+        line.remove_prefix(separator + 1);
+    }
+    else if (_waiting_sessions.size() == 1) {
+        waiting_session = _waiting_sessions.begin();
+    }
+    else {
+        std::cout << "Start the line with the number of the session that it is for, e.g. \"" << _waiting_sessions.begin()->first << ' ' << line << "\"\n";
+        return;
+    }
+    // The session stops waiting before getting the input, so that it can wait for the next one
+    const auto session = waiting_session->first;
+    auto       on_line = std::move(waiting_session->second);
+    _waiting_sessions.erase(waiting_session);
+    if (!on_line(line)) {
+        std::cout << "Invalid input, try again!\n";
+        _waiting_sessions.emplace(session, std::move(on_line));
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <chrono>
+#include <functional>
+#include <map>
+#include <string_view>
+#include <utility>
+#include "input_source.h"
+
+/// Lets several games wait for inputs and for timers on a single thread, without blocking it:
+/// instead of waiting for an input, a game asks the reactor to call a function with it, and returns.
+/// When several sessions wait for an input at the same time, each line must start with the number of its session (e.g. "2 42"),
+/// which is the number that a ScreenMultiplexer shows in front of the lines of the session.
+class InputReactor {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit InputReactor(InputSource& input)
+        : _input{input}
+    {
+    }
+
+    /// Calls `on_input` with the next input of type T of `session`
+    /// The invalid inputs are refused, and the session keeps waiting. A session can only wait for one input at a time.
+    template<typename T>
+    void read_input(size_t session, std::function<void(T)> on_input)
+    {
+        read_line(session, [on_input = std::move(on_input)](std::string_view line) {
+            const auto input = parse_input<T>(line);
+            if (input.has_value()) {
+                on_input(*input);
+            }
+            return input.has_value();
+        });
+    }
+
+    /// Calls `on_line` with the next line of `session`, which returns false to refuse it if it is not a valid input, so that the session keeps waiting
+    void read_line(size_t session, std::function<bool(std::string_view)> on_line) { _waiting_sessions[session] = std::move(on_line); }
+
+    /// Calls `on_time` once `delay` has passed
+    void after(std::chrono::milliseconds delay, std::function<void()> on_time);
+
+    /// Reads the inputs and waits for the timers, and calls the functions that wait for them, as long as a session waits for an input
+    /// Returns early if the input ends.
+    void run();
+
+private:
+    /// Gives `line` to the session that it is for
+    void dispatch(std::string_view line);
+
+private:
+    InputSource&                                            _input;
+    std::map<size_t, std::function<bool(std::string_view)>> _waiting_sessions; // The functions return false when the line is not a valid input
+    std::multimap<Clock::time_point, std::function<void()>> _timers;
+};
@@ -0,0 +1,178 @@
+#include "input_source.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <io.h>
+#include <windows.h>
+#else
+#include <cerrno>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+InputSource InputSource::console()
+{
+    return InputSource{true, {}};
+}
+
+InputSource InputSource::buffer(std::string text)
+{
+    return InputSource{false, std::move(text)};
+}
+
+std::optional<InputSource> InputSource::script(const std::filesystem::path& path)
+{
+    auto file = std::ifstream{path, std::ios::binary};
+    if (!file) {
+        return std::nullopt;
+    }
+    return buffer(std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}});
+}
+
+/// Reads at most `size` bytes of the standard input, and returns how many were read (0 at the end of the input, or if it could not be read)
+/// Returns as soon as some bytes are available, instead of waiting for `size` bytes like std::fread() would.
+static size_t read_standard_input(char* buffer, size_t size)
+{
+#if defined(_WIN32)
+    const auto count = _read(0, buffer, static_cast<unsigned int>(size));
+#else
+    auto count = ::read(STDIN_FILENO, buffer, size);
+    while (count < 0 && errno == EINTR) {
+        count = ::read(STDIN_FILENO, buffer, size);
+    }
+#endif
+    return count > 0 ? static_cast<size_t>(count) : 0;
+}
+
+/// Waits at most `timeout` (or as long as needed without one) until the standard input has something to read or has ended
+/// Returns false if the time ran out first.
+static bool wait_for_standard_input(std::optional<std::chrono::milliseconds> timeout)
+{
+#if defined(_WIN32)
+    // The console is signaled by any event (e.g. a key press), so the read that follows can still wait for the end of the line
+    const auto milliseconds = timeout.has_value() ? static_cast<DWORD>(timeout->count()) : INFINITE;
+    return WaitForSingleObject(GetStdHandle(STD_INPUT_HANDLE), milliseconds) == WAIT_OBJECT_0;
+#else
+    auto request = pollfd{STDIN_FILENO, POLLIN, 0};
+    auto result  = ::poll(&request, 1, timeout.has_value() ? static_cast<int>(timeout->count()) : -1);
+    while (result < 0 && errno == EINTR) {
+        result = ::poll(&request, 1, timeout.has_value() ? static_cast<int>(timeout->count()) : -1);
+    }
+    return result != 0;
+#endif
+}
+
+bool InputSource::read_more_from_console()
+{
+    static constexpr size_t chunk_size = 1 << 16;
+
+    _text.erase(0, _position);
+    _position       = 0;
+    const auto size = _text.size();
+    _text.resize(size + chunk_size);
+    const auto count = read_standard_input(_text.data() + size, chunk_size);
+    _text.resize(size + count);
+    _console_ended = count == 0;
+    return count != 0;
+}
+
+std::optional<std::string_view> InputSource::next_line()
+{
+    auto line_end = _text.find('\n', _position);
+    while (line_end == std::string::npos && _is_console) {
+        const auto searched_size = _text.size() - _position; // The beginning of the line has already been searched
+        if (!read_more_from_console()) {
+            break;
+        }
+        line_end = _text.find('\n', searched_size);
+    }
+    if (_position >= _text.size()) {
+        return std::nullopt;
+    }
+    line_end        = std::min(line_end, _text.size()); // The last line doesn't always end with an end of line
+    const auto line = std::string_view{_text}.substr(_position, line_end - _position);
+    _position       = line_end + 1;
+    return line;
+}
+
+std::optional<std::string_view> InputSource::peek_line()
+{
+    if (_is_console) {
+        return std::nullopt;
+    }
+    const auto position = _position;
+    const auto line     = next_line();
+    _position           = position;
+    return line;
+}
+
+bool InputSource::wait_for_line(std::optional<std::chrono::milliseconds> timeout)
+{
+    const auto deadline = std::chrono::steady_clock::now() + timeout.value_or(std::chrono::milliseconds{0});
+    while (_is_console && !_console_ended && _text.find('\n', _position) == std::string::npos) {
+        auto remaining = std::optional<std::chrono::milliseconds>{};
+        if (timeout.has_value()) {
+            remaining = std::max(std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()), std::chrono::milliseconds{0});
+        }
+        if (!wait_for_standard_input(remaining)) {
+            return false;
+        }
+        read_more_from_console();
+    }
+    return true;
+}
+
+bool is_blank(std::string_view line)
+{
+    return line.find_first_not_of(" \t\r") == std::string_view::npos;
+}
+
+/// Reads the integers of the standard input like get_input_from_user() did before it had an InputSource
+static size_t read_integers_with_iostream(int64_t& sum)
+{
+    size_t count = 0;
+    int    input; // NOLINT
+    while (true) {
+        while (!(std::cin >> input)) {
+            if (std::cin.eof()) {
+                return count;
+            }
+            std::cin.clear();
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        }
+        sum += input;
+        count++;
+    }
+}
+
+/// Reads the integers of the standard input like get_input_from_user() does
+static size_t read_integers_with_input_source(int64_t& sum)
+{
+    size_t count   = 0;
+    auto   console = InputSource::console();
+    while (const auto line = console.next_line()) {
+        if (const auto input = parse_input<int>(*line); input.has_value()) {
+            sum += *input;
+            count++;
+        }
+    }
+    return count;
+}
+
+int benchmark_input(const std::vector<std::string_view>& arguments)
+{
+    const bool with_iostream = !arguments.empty() && arguments[0] == "iostream";
+    int64_t    sum           = 0;
+    const auto begin         = std::chrono::steady_clock::now();
+    const auto count         = with_iostream ? read_integers_with_iostream(sum) : read_integers_with_input_source(sum);
+    const auto seconds       = std::chrono::duration<double>{std::chrono::steady_clock::now() - begin}.count();
+    std::cout << "Read " << count << " integers with " << (with_iostream ? "std::cin" : "InputSource") << " in " << seconds << "s: "
+              << static_cast<double>(count) / seconds / 1e6 << " million lines per second (sum " << sum << ")\n";
+    return 0;
+}
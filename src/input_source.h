@@ -0,0 +1,96 @@
+#pragma once
+#include <charconv>
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// Where get_input_from_user() reads the inputs from, one input per line: the console, a script file or a text in memory
+/// The lines of a script or of a text are read from memory, so that games can be played from a script as fast as they can run.
+/// The console is read without going through std::cin: each read gets all that the standard input has to give (a line typed by the user, or a big chunk of a pipe),
+/// and the lines are then found in memory, so that there is no locale nor synchronisation with stdio to pay for on each input.
+class InputSource {
+public:
+    /// Reads the lines that the user types in the console
+    static InputSource console();
+
+    /// Reads the lines of `text`
+    static InputSource buffer(std::string text);
+
+    /// Reads the lines of the file at `path`, which is read at once
+    /// Returns std::nullopt if the file could not be read.
+    static std::optional<InputSource> script(const std::filesystem::path& path);
+
+    /// Returns the next line without its end of line, or std::nullopt once there is nothing left to read
+    /// The line stays valid until the next call.
+    std::optional<std::string_view> next_line();
+
+    /// Returns the line that next_line() will return, without reading it
+    /// Always returns std::nullopt for the console, which can't be read ahead without blocking.
+    std::optional<std::string_view> peek_line();
+
+    /// Waits at most `timeout` (or as long as needed without one) until next_line() can return without blocking,
+    /// because a whole line has been read or because the input has ended. Returns false if the time ran out first.
+    /// Texts and scripts are always ready.
+    bool wait_for_line(std::optional<std::chrono::milliseconds> timeout);
+
+    /// Reads the text or the script from its first line again (does nothing for the console)
+    void rewind() { _position = 0; }
+
+    bool is_console() const { return _is_console; }
+
+private:
+    InputSource(bool is_console, std::string text)
+        : _is_console{is_console}
+        , _text{std::move(text)}
+    {
+    }
+
+    /// Appends what the standard input has to give to `_text`, after removing the lines that have already been read
+    /// Returns false once there is nothing left to read.
+    bool read_more_from_console();
+
+private:
+    bool        _is_console;
+    bool        _console_ended{false};
+    std::string _text; // The whole text, or what has been read from the console and not returned yet
+    size_t      _position{0};
+};
+
+/// Returns true if `line` only contains spaces
+bool is_blank(std::string_view line);
+
+/// Returns the value of type T that is written on `line`, with or without spaces around it, or std::nullopt if the line is not a valid T
+/// A char must be the only character of the line (other than spaces).
+template<typename T>
+std::optional<T> parse_input(std::string_view line)
+{
+    static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>, "Only characters and integers can be parsed");
+    const auto begin = line.find_first_not_of(" \t\r");
+    if (begin == std::string_view::npos) {
+        return std::nullopt;
+    }
+    line = line.substr(begin, line.find_last_not_of(" \t\r") + 1 - begin);
+    if constexpr (std::is_same_v<T, char>) {
+        if (line.size() != 1) {
+            return std::nullopt;
+        }
+        return line[0];
+    }
+    else {
+        T          value{};
+        const auto result = std::from_chars(line.data(), line.data() + line.size(), value);
+        if (result.ec != std::errc{} || result.ptr != line.data() + line.size()) {
+            return std::nullopt;
+        }
+        return value;
+    }
+}
+
+/// Measures how fast the integers of the standard input, one per line, are read by get_input_from_user(), e.g. `seq 10000000 | SimpleCpp benchmark-input`
+/// With the argument "iostream", measures how fast they are read with std::cin instead.
+int benchmark_input(const std::vector<std::string_view>& arguments);
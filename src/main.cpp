@@ -1,6 +1,14 @@
+#include <string_view>
+#include <vector>
 #include "menu.h"
+#include "options.h"
+#include "tools.h"
 
-int main()
+int main(int argc, char* argv[])
 {
+    const auto arguments = parse_options(std::vector<std::string_view>(argv + 1, argv + argc));
+    if (!arguments.empty()) {
+        return run_tool(arguments);
+    }
     show_menu();
 }
@@ -0,0 +1,220 @@
+#include "mcts.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "input_source.h"
+#include "rand.h"
+#include "session.h"
+
+static constexpr std::array<uint8_t, 512> bits_count = [] {
+    auto table = std::array<uint8_t, 512>{};
+    for (size_t mask = 1; mask < table.size(); ++mask) {
+        table[mask] = static_cast<uint8_t>(table[mask & (mask - 1)] + 1);
+    }
+    return table;
+}();
+
+/// Returns the index of the n-th bit set in `mask` (n starts at 0)
+int nth_set_bit(uint16_t mask, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; ++i) {
+        mask &= mask - 1; // Clears the lowest bit set
+    }
+    int index = 0;
+    while (!(mask & (1u << index))) {
+        index++;
+    }
+    return index;
+}
+
+template<typename Generator>
+int random_legal_move(const UltimateBoard& board, Generator& generator)
+{
+    if (board.forced_sub_board != -1) {
+        const auto empty = empty_cells(board, board.forced_sub_board);
+        return board.forced_sub_board * 9 + nth_set_bit(empty, generator.below(uint32_t{bits_count[empty]}));
+    }
+    uint32_t moves_count = 0;
+    for (int sub_board = 0; sub_board < 9; ++sub_board) {
+        moves_count += bits_count[empty_cells(board, sub_board)];
+    }
+    auto n = generator.below(moves_count);
+    for (int sub_board = 0;; ++sub_board) {
+        const auto empty = empty_cells(board, sub_board);
+        if (n < bits_count[empty]) {
+            return sub_board * 9 + nth_set_bit(empty, n);
+        }
+        n -= bits_count[empty];
+    }
+}
+
+/// Plays random moves until the game is over and returns the winner (std::nullopt for a draw)
+template<typename Generator>
+std::optional<UltimatePlayer> random_playout(UltimateBoard board, Generator& generator)
+{
+    while (!game_is_over(board)) {
+        play(board, random_legal_move(board, generator));
+    }
+    return winner(board);
+}
+
+struct MctsNode {
+    int            parent;
+    int            move;
+    UltimatePlayer player_who_moved;
+    int            first_child{-1};
+    int            children_count{};
+    int            visits{};
+    float          score{}; // Sum of the playouts results from the point of view of `player_who_moved`: 1 for a win, 0.5 for a draw
+};
+
+/// Upper Confidence bound applied to Trees: balances exploiting the moves that look good and exploring the ones we know little about
+int child_with_best_uct(const std::vector<MctsNode>& tree, const MctsNode& node)
+{
+    static constexpr float exploration = 1.41421356f;
+    const float            log_visits  = std::log(static_cast<float>(node.visits));
+    int                    best_child  = node.first_child;
+    float                  best_uct    = -1.f;
+    for (int child = node.first_child; child < node.first_child + node.children_count; ++child) {
+        const auto& child_node = tree[static_cast<size_t>(child)];
+        if (child_node.visits == 0) {
+            return child;
+        }
+        const auto visits = static_cast<float>(child_node.visits);
+        const auto uct    = child_node.score / visits + exploration * std::sqrt(log_visits / visits);
+        if (uct > best_uct) {
+            best_uct   = uct;
+            best_child = child;
+        }
+    }
+    return best_child;
+}
+
+void expand(std::vector<MctsNode>& tree, int node, const UltimateBoard& board)
+{
+    auto       moves       = std::array<uint8_t, 81>{};
+    const auto moves_count = legal_moves(board, moves);
+    tree[static_cast<size_t>(node)].first_child    = static_cast<int>(tree.size());
+    tree[static_cast<size_t>(node)].children_count = moves_count;
+    for (int i = 0; i < moves_count; ++i) {
+        tree.push_back({node, moves[static_cast<size_t>(i)], board.current_player});
+    }
+}
+
+void backpropagate(std::vector<MctsNode>& tree, int node, std::optional<UltimatePlayer> winner)
+{
+    while (node != -1) {
+        auto& current = tree[static_cast<size_t>(node)];
+        current.visits++;
+        if (!winner.has_value()) {
+            current.score += 0.5f;
+        }
+        else if (*winner == current.player_who_moved) {
+            current.score += 1.f;
+        }
+        node = current.parent;
+    }
+}
+
+MctsResult mcts_best_move(const UltimateBoard& board, std::chrono::milliseconds thinking_budget, std::optional<int> playouts_count)
+{
+    static constexpr size_t max_nodes_count = 4'000'000; // Once reached we keep doing playouts but stop growing the tree, to bound the memory usage
+
+    const auto deadline  = std::chrono::steady_clock::now() + thinking_budget;
+    auto       generator = next_random_stream(); // A copy of the stream, so that the playouts don't go through a thread_local
+    auto       tree      = std::vector<MctsNode>{};
+    tree.reserve(1024);
+    tree.push_back({-1, -1, other_player(board.current_player)});
+    expand(tree, 0, board);
+
+    int        playouts  = 0;
+    const auto must_stop = [&]() {
+        if (playouts_count.has_value()) {
+            return playouts >= *playouts_count;
+        }
+        return playouts % 128 == 0 && std::chrono::steady_clock::now() >= deadline;
+    };
+    while (!must_stop()) {
+        // Selection
+        auto state = board;
+        int  node  = 0;
+        while (tree[static_cast<size_t>(node)].children_count != 0) {
+            node = child_with_best_uct(tree, tree[static_cast<size_t>(node)]);
+            play(state, tree[static_cast<size_t>(node)].move);
+        }
+        // Expansion: a node gets children the second time we reach it, so that the tree doesn't grow with each playout
+        if (!game_is_over(state) && tree[static_cast<size_t>(node)].visits > 0 && tree.size() < max_nodes_count) {
+            expand(tree, node, state);
+            node = tree[static_cast<size_t>(node)].first_child;
+            play(state, tree[static_cast<size_t>(node)].move);
+        }
+        // Simulation
+        const auto result = random_playout(state, generator);
+        playouts++;
+        // Backpropagation
+        backpropagate(tree, node, result);
+    }
+
+    const auto& root       = tree[0];
+    int         best_child = root.first_child;
+    for (int child = root.first_child; child < root.first_child + root.children_count; ++child) {
+        if (tree[static_cast<size_t>(child)].visits > tree[static_cast<size_t>(best_child)].visits) {
+            best_child = child;
+        }
+    }
+    return {tree[static_cast<size_t>(best_child)].move, playouts};
+}
+
+int simulate_random_playouts(const std::vector<std::string_view>& arguments)
+{
+    const auto games_count_argument   = arguments.empty() ? std::nullopt : parse_input<size_t>(arguments[0]);
+    const auto threads_count_argument = arguments.size() > 1 ? parse_input<unsigned int>(arguments[1]) : std::max(1u, std::thread::hardware_concurrency());
+    if (games_count_argument.value_or(0) == 0 || threads_count_argument.value_or(0) == 0) {
+        std::cout << "Usage: simulate-playouts <number of games> [number of threads] [--seed <number>]\n"
+                  << "The numbers of games and of threads must be positive\n";
+        return 1;
+    }
+    const auto games_count   = *games_count_argument;
+    const auto threads_count = *threads_count_argument;
+
+    // Each game draws from the stream of its index, so its result is the same whichever thread plays it, and the threads can take the batches in any order.
+    // The results are stored by game, so that they can be compared from one run to the next.
+    static constexpr size_t batch_size = 256;
+    const auto              seed       = session_seed();
+    auto                    next_batch = std::atomic<size_t>{0};
+    auto                    results    = std::vector<uint8_t>(games_count); // The index of the winner plus one, or 0 for a draw
+    auto                    threads    = std::vector<std::thread>{};
+    const auto              begin      = std::chrono::steady_clock::now();
+    for (unsigned int thread = 0; thread < threads_count; ++thread) {
+        threads.emplace_back([&]() {
+            for (size_t batch_begin = next_batch.fetch_add(batch_size); batch_begin < games_count; batch_begin = next_batch.fetch_add(batch_size)) {
+                const auto batch_end = std::min(batch_begin + batch_size, games_count);
+                for (size_t game = batch_begin; game < batch_end; ++game) {
+                    auto       generator = CounterRandomGenerator{seed, game};
+                    const auto winner    = random_playout(UltimateBoard{}, generator);
+                    results[game]        = winner.has_value() ? static_cast<uint8_t>(index_of(*winner) + 1) : 0;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    const auto seconds = std::chrono::duration<double>{std::chrono::steady_clock::now() - begin}.count();
+
+    auto     outcomes_count = std::array<size_t, 3>{};
+    uint64_t fingerprint    = 0xCBF29CE484222325; // FNV-1a of the results in the order of the games
+    for (const auto result : results) {
+        outcomes_count[result]++;
+        fingerprint = (fingerprint ^ result) * 0x100000001B3;
+    }
+    std::cout << "Played " << games_count << " random games with " << threads_count << " threads and the seed " << seed << " in " << seconds << "s: "
+              << static_cast<double>(games_count) / seconds << " games per second\n"
+              << "X won " << outcomes_count[index_of(UltimatePlayer::Crosses) + 1] << ", O won " << outcomes_count[index_of(UltimatePlayer::Noughts) + 1]
+              << ", draws: " << outcomes_count[0] << '\n'
+              << "Fingerprint of the results: " << std::hex << fingerprint << std::dec << '\n';
+    return 0;
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include <chrono>
+#include <optional>
+#include <string_view>
+#include <vector>
+#include "ultimate_board.h"
+
+struct MctsResult {
+    int move;
+    int playouts; // How many random games have been simulated to pick the move
+};
+
+/// Uses Monte Carlo Tree Search to find a good move for `board.current_player`
+/// It thinks for `thinking_budget` and then returns the move that has been explored the most
+/// If `playouts_count` is given, it does exactly this number of playouts instead, whatever the time it takes, so that its move can be replayed.
+/// `board` must not be a finished game
+MctsResult mcts_best_move(const UltimateBoard& board, std::chrono::milliseconds thinking_budget, std::optional<int> playouts_count);
+
+/// Plays random games of ultimate noughts and crosses on several threads and shows how often each player wins
+/// Each game has its own random stream, so that the results only depend on the seed of the session and not on the number of threads.
+int simulate_random_playouts(const std::vector<std::string_view>& arguments);
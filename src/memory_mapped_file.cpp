@@ -0,0 +1,120 @@
+#include "memory_mapped_file.h"
+#include <utility>
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(_WIN32)
+
+std::optional<MemoryMappedFile> MemoryMappedFile::open(const std::filesystem::path& path)
+{
+    auto file         = MemoryMappedFile{};
+    file._file_handle = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file._file_handle == INVALID_HANDLE_VALUE) {
+        file._file_handle = nullptr;
+        return std::nullopt;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file._file_handle, &size)) {
+        return std::nullopt;
+    }
+    file._size = static_cast<size_t>(size.QuadPart);
+    if (file._size == 0) { // Empty files can't be mapped, but they are valid files nonetheless
+        return std::make_optional(std::move(file));
+    }
+    file._mapping_handle = CreateFileMappingW(file._file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (file._mapping_handle == nullptr) {
+        return std::nullopt;
+    }
+    file._data = static_cast<const char*>(MapViewOfFile(file._mapping_handle, FILE_MAP_READ, 0, 0, 0));
+    if (file._data == nullptr) {
+        return std::nullopt;
+    }
+    return std::make_optional(std::move(file));
+}
+
+void MemoryMappedFile::close()
+{
+    if (_data != nullptr) {
+        UnmapViewOfFile(_data);
+    }
+    if (_mapping_handle != nullptr) {
+        CloseHandle(_mapping_handle);
+    }
+    if (_file_handle != nullptr) {
+        CloseHandle(_file_handle);
+    }
+    _data           = nullptr;
+    _size           = 0;
+    _mapping_handle = nullptr;
+    _file_handle    = nullptr;
+}
+
+#else
+
+std::optional<MemoryMappedFile> MemoryMappedFile::open(const std::filesystem::path& path)
+{
+    const int file_descriptor = ::open(path.c_str(), O_RDONLY); // NOLINT(cppcoreguidelines-pro-type-vararg)
+    if (file_descriptor == -1) {
+        return std::nullopt;
+    }
+    struct stat file_status {};
+    if (fstat(file_descriptor, &file_status) == -1) {
+        ::close(file_descriptor);
+        return std::nullopt;
+    }
+    auto file  = MemoryMappedFile{};
+    file._size = static_cast<size_t>(file_status.st_size);
+    if (file._size != 0) { // Empty files can't be mapped, but they are valid files nonetheless
+        void* const data = mmap(nullptr, file._size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+        if (data == MAP_FAILED) {
+            ::close(file_descriptor);
+            return std::nullopt;
+        }
+        file._data = static_cast<const char*>(data);
+    }
+    ::close(file_descriptor); // The mapping stays valid after the file is closed
+    return std::make_optional(std::move(file));
+}
+
+void MemoryMappedFile::close()
+{
+    if (_data != nullptr) {
+        munmap(const_cast<char*>(_data), _size); // NOLINT(cppcoreguidelines-pro-type-const-cast)
+    }
+    _data = nullptr;
+    _size = 0;
+}
+
+#endif
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    close();
+}
+
+MemoryMappedFile::MemoryMappedFile(MemoryMappedFile&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+MemoryMappedFile& MemoryMappedFile::operator=(MemoryMappedFile&& other) noexcept
+{
+    if (this != &other) {
+        close();
+        _data = std::exchange(other._data, nullptr);
+        _size = std::exchange(other._size, 0);
+#if defined(_WIN32)
+        _file_handle    = std::exchange(other._file_handle, nullptr);
+        _mapping_handle = std::exchange(other._mapping_handle, nullptr);
+#endif
+    }
+    return *this;
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+
+/// A read-only view of the content of a whole file
+/// Nothing is copied: the OS loads the pages of the file lazily, when we read them
+class MemoryMappedFile {
+public:
+    /// Returns std::nullopt if the file can't be opened
+    static std::optional<MemoryMappedFile> open(const std::filesystem::path& path);
+
+    ~MemoryMappedFile();
+    MemoryMappedFile(const MemoryMappedFile&)            = delete;
+    MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+    MemoryMappedFile(MemoryMappedFile&& other) noexcept;
+    MemoryMappedFile& operator=(MemoryMappedFile&& other) noexcept;
+
+    const char*      data() const { return _data; }
+    size_t           size() const { return _size; }
+    std::string_view content() const { return {_data, _size}; }
+
+private:
+    MemoryMappedFile() = default;
+    void close();
+
+private:
+    const char* _data{nullptr};
+    size_t      _size{0};
+#if defined(_WIN32)
+    void* _file_handle{nullptr};
+    void* _mapping_handle{nullptr};
+#endif
+};
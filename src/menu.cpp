@@ -1,11 +1,18 @@
 #include "menu.h"
+#include <chrono>
 #include <functional>
+#include <iostream>
 #include <unordered_map>
 #include "connect_4.h"
+#include "evil_hangman.h"
 #include "get_input_from_user.h"
 #include "hangman.h"
 #include "noughts_and_crosses.h"
 #include "play_guess_the_number.h"
+#include "qubic.h"
+#include "rand.h"
+#include "session.h"
+#include "ultimate_noughts_and_crosses.h"
 
 struct Game {
     std::string           name;
@@ -17,6 +24,14 @@ static const std::unordered_map<char, Game> games{
     {'2', {"Hangman", &play_hangman}},
     {'3', {"Noughts and Crosses", &play_noughts_and_crosses}},
     {'4', {"Connect 4", &play_connect_4}},
+    {'5', {"Ultimate Noughts and Crosses", &play_ultimate_noughts_and_crosses}},
+    {'6', {"Qubic", &play_qubic}},
+    {'7', {"Misere Noughts and Crosses", &play_misere_noughts_and_crosses}},
+    {'8', {"Gravity Noughts and Crosses", &play_gravity_noughts_and_crosses}},
+    {'9', {"Connect 3", &play_connect_3}},
+    {'a', {"Evil Hangman", &play_evil_hangman}},
+    {'b', {"Liar Guess the Number", &play_liar_guess_the_number}},
+    {'c', {"Guess the Number, three games at once", &play_guess_the_number_sessions}},
 };
 
 void show_the_list_of_commands(const std::unordered_map<char, Game>& games)
@@ -47,4 +62,50 @@ void show_menu()
             }
         }
     }
-}
\ No newline at end of file
+}
+
+int run_script(const std::vector<std::string_view>& arguments)
+{
+    const auto runs_count_argument = arguments.size() > 1 ? parse_input<int>(arguments[1]) : 1;
+    if (arguments.empty() || runs_count_argument.value_or(0) <= 0) {
+        std::cout << "Usage: run-script <file> [number of times, at least 1]\n";
+        return 1;
+    }
+    auto script = InputSource::script(std::filesystem::path{arguments[0]});
+    if (!script.has_value()) {
+        std::cout << "Could not read \"" << arguments[0] << "\"\n";
+        return 1;
+    }
+    const int runs_count = *runs_count_argument;
+
+    // A log of a session can be used as a script: its seed is used for all the runs, so that they all play the same games as the session
+    const auto seed             = seed_of_log(*script);
+    const bool starts_with_seed = seed.has_value();
+    auto       last_input       = std::string{};
+    while (const auto line = script->next_line()) {
+        if (!is_blank(*line)) {
+            last_input = *line;
+        }
+    }
+    // Once there is nothing left to read the program quits, so the script must quit the menu for the next run to start
+    if (parse_input<char>(last_input) != 'q') {
+        std::cout << "The script must end with \"q\", to quit the menu\n";
+        return 1;
+    }
+
+    use_script_as_session_input(&*script);
+    const auto begin = std::chrono::steady_clock::now();
+    for (int run = 0; run < runs_count; ++run) {
+        script->rewind();
+        if (starts_with_seed) {
+            script->next_line();
+        }
+        thread_random_generator() = RandomGenerator{seed.value_or(session_seed())}; // Like the first stream of a session with this seed
+        show_menu();
+    }
+    const auto seconds = std::chrono::duration<double>{std::chrono::steady_clock::now() - begin}.count();
+    use_script_as_session_input(nullptr);
+    // The games write to the standard output, which can be redirected to measure their speed alone
+    std::cerr << "Ran the script " << runs_count << " times in " << seconds << "s: " << runs_count / seconds << " sessions per second\n";
+    return 0;
+}
\ No newline at end of file
@@ -1,3 +1,9 @@
 #pragma once
+#include <string_view>
+#include <vector>
 
-void show_menu();
\ No newline at end of file
+void show_menu();
+
+/// Plays the sessions of a script (e.g. the log of a session) without waiting for the user, as many times as asked,
+/// and measures how many sessions per second can be played. Each line of the script is an input.
+int run_script(const std::vector<std::string_view>& arguments);
\ No newline at end of file
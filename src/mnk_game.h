@@ -0,0 +1,74 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include "board.h"
+#include "game_rules.h"
+#include "tablebase.h"
+
+/// Describes a game played with `GameRules` (see game_rules.h) for compute_tablebase()
+/// The positions are indexed by the placement policy of the rules, which also tells how to walk the moves backwards.
+template<typename GameRules>
+struct MnkGame {
+    static constexpr int width       = GameRules::width;
+    static constexpr int height      = GameRules::height;
+    static constexpr int line_length = GameRules::line_length;
+    using Placement                  = typename GameRules::PlacementPolicy;
+    using Board                      = BoardT<width, height, Side>;
+
+    struct Position {
+        Board board;
+        Side  side_to_move;
+    };
+
+    static constexpr uint64_t positions_count = Placement::template positions_count<width, height>();
+
+    template<typename Player>
+    static uint64_t index_of(const BoardT<width, height, Player>& board, Player first_player)
+    {
+        return Placement::index_of(board, first_player);
+    }
+
+    static std::optional<Position> decode(uint64_t index)
+    {
+        auto       position     = Position{Placement::template board_at<width, height>(index), Side::First};
+        const auto first_count  = std::count(position.board.begin(), position.board.end(), Side::First);
+        const auto second_count = std::count(position.board.begin(), position.board.end(), Side::Second);
+        if (first_count == second_count) {
+            position.side_to_move = Side::First;
+        }
+        else if (first_count == second_count + 1) {
+            position.side_to_move = Side::Second;
+        }
+        else {
+            return std::nullopt;
+        }
+        if (has_aligned<line_length>(position.board, position.side_to_move)) { // The game would have ended before the opponent could play
+            return std::nullopt;
+        }
+        return std::make_optional(position);
+    }
+
+    static std::optional<GameResult> terminal_result(const Position& position)
+    {
+        if (player_who_aligned<line_length>(position.board).has_value()) { // It can only be the player who just played, see decode()
+            return GameRules::EndingPolicy::aligning_wins ? GameResult::Loss : GameResult::Win;
+        }
+        if (board_is_full(position.board)) {
+            return GameResult::Draw;
+        }
+        return std::nullopt;
+    }
+
+    static int moves_count(const Position& position)
+    {
+        return Placement::moves_count(position.board);
+    }
+
+    template<typename Callback>
+    static void for_each_predecessor(const Position& position, uint64_t index, Callback&& callback)
+    {
+        Placement::for_each_predecessor(position.board, index, other_side(position.side_to_move), std::forward<Callback>(callback));
+    }
+};
@@ -1,17 +1,23 @@
 #include "noughts_and_crosses.h"
 #include <p6/p6.h>
 #include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <memory>
 #include "board.h"
+#include "mnk_game.h"
+#include "rand.h"
+#include "tablebase.h"
 
 enum class Player {
     Noughts,
     Crosses,
 };
 
-using Board = BoardT<3, 3, Player>;
+template<typename GameRules>
+using BoardFor = typename GameRules::template Board<Player>;
 
-void draw_nought(CellIndex index, int board_size, p6::Context& ctx)
+void draw_nought(CellIndex index, BoardSize board_size, p6::Context& ctx)
 {
     ctx.stroke        = {0, 0, 0};
     ctx.fill          = {0, 0, 0, 0};
@@ -20,7 +26,7 @@ void draw_nought(CellIndex index, int board_size, p6::Context& ctx)
                p6::Radius{0.9f * cell_radius(board_size)});
 }
 
-void draw_cross(CellIndex index, int board_size, p6::Context& ctx)
+void draw_cross(CellIndex index, BoardSize board_size, p6::Context& ctx)
 {
     ctx.stroke          = {0, 0, 0};
     ctx.fill            = {0, 0, 0, 0};
@@ -32,16 +38,17 @@ void draw_cross(CellIndex index, int board_size, p6::Context& ctx)
     ctx.rectangle(center, radii, -rotation);
 }
 
-std::optional<CellIndex> cell_hovered_by(glm::vec2 position, int board_size)
+std::optional<CellIndex> cell_hovered_by(glm::vec2 position, BoardSize board_size)
 {
-    const auto pos   = p6::map(position,
-                             glm::vec2{-1.f}, glm::vec2{1.f},
-                             glm::vec2{0.f}, glm::vec2{static_cast<float>(board_size)});
-    const auto index = CellIndex{
+    const float ratio = aspect_ratio(board_size);
+    const auto  pos   = p6::map(position,
+                                glm::vec2{-ratio, -1.f}, glm::vec2{ratio, 1.f},
+                                glm::vec2{0.f}, glm::vec2{static_cast<float>(board_size.width), static_cast<float>(board_size.height)});
+    const auto  index = CellIndex{
         static_cast<int>(std::floor(pos.x)),
         static_cast<int>(std::floor(pos.y))};
-    if (index.x >= 0 && index.x < board_size &&
-        index.y >= 0 && index.y < board_size) {
+    if (index.x >= 0 && index.x < board_size.width &&
+        index.y >= 0 && index.y < board_size.height) {
         return std::make_optional(index);
     }
     else {
@@ -49,7 +56,7 @@ std::optional<CellIndex> cell_hovered_by(glm::vec2 position, int board_size)
     }
 }
 
-void draw_player(Player player, CellIndex index, int board_size, p6::Context& ctx)
+void draw_player(Player player, CellIndex index, BoardSize board_size, p6::Context& ctx)
 {
     if (player == Player::Noughts) {
         draw_nought(index, board_size, ctx);
@@ -59,13 +66,14 @@ void draw_player(Player player, CellIndex index, int board_size, p6::Context& ct
     }
 }
 
-void draw_noughts_and_crosses(const Board& board, p6::Context& ctx)
+template<typename BoardType>
+void draw_noughts_and_crosses(const BoardType& board, p6::Context& ctx)
 {
     for (int x = 0; x < board.width(); ++x) {
         for (int y = 0; y < board.height(); ++y) {
-            const auto cell = board[{x, y}];
+            const auto& cell = board[{x, y}];
             if (cell.has_value()) {
-                draw_player(*cell, {x, y}, board.height(), ctx);
+                draw_player(*cell, {x, y}, board.size(), ctx);
             }
         }
     }
@@ -81,76 +89,79 @@ void change_player(Player& player)
     }
 }
 
-void try_to_play(std::optional<CellIndex> cell_index, Board& board, Player& current_player)
+/// Returns true iff the rules allowed `current_player` to play in that cell and they did
+template<typename GameRules>
+bool try_to_play(std::optional<CellIndex> cell_index, BoardFor<GameRules>& board, Player& current_player)
 {
     if (cell_index.has_value()) {
-        const auto cell_is_empty = !board[*cell_index].has_value();
-        if (cell_is_empty) {
-            board[*cell_index] = current_player;
+        const auto landing_cell = GameRules::landing_cell(board, *cell_index);
+        if (landing_cell.has_value()) {
+            board[*landing_cell] = current_player;
             change_player(current_player);
+            return true;
         }
     }
+    return false;
 }
 
-void try_draw_player_on_hovered_cell(Player player, Board board, p6::Context& ctx)
+template<typename GameRules>
+void try_draw_player_on_hovered_cell(Player player, const BoardFor<GameRules>& board, std::optional<CellIndex> hovered_cell, p6::Context& ctx)
 {
-    const auto hovered_cell = cell_hovered_by(ctx.mouse(), board.height());
-    if (hovered_cell.has_value() && !board[*hovered_cell].has_value()) {
-        draw_player(player, *hovered_cell, board.height(), ctx);
+    if (hovered_cell.has_value()) {
+        const auto landing_cell = GameRules::landing_cell(board, *hovered_cell);
+        if (landing_cell.has_value()) {
+            draw_player(player, *landing_cell, board.size(), ctx);
+        }
     }
 }
 
-std::optional<Player> check_for_winner_on_line(const Board& board, std::function<CellIndex(int)> index_generator)
+template<typename GameRules>
+void draw_frame(const BoardFor<GameRules>& board, Player current_player, std::optional<CellIndex> hovered_cell, p6::Context& ctx)
 {
-    const bool are_all_equal = [&]() {
-        for (int position = 0; position < board.height() - 1; ++position) {
-            if (board[index_generator(position)] != board[index_generator(position + 1)]) {
-                return false;
-            }
-        }
-        return true;
-    }();
-    if (are_all_equal && board[index_generator(0)].has_value()) {
-        return *board[index_generator(0)];
-    }
-    else {
-        return std::nullopt;
-    }
+    ctx.background({.3f, 0.25f, 0.35f});
+    ctx.stroke_weight = 0.01f;
+    ctx.stroke        = {1.f, 1.f, 1.f, 1.f};
+    ctx.fill          = {0.f, 0.f, 0.f, 0.f};
+    draw_board(board.size(), ctx);
+    draw_noughts_and_crosses(board, ctx);
+    try_draw_player_on_hovered_cell<GameRules>(current_player, board, hovered_cell, ctx);
 }
 
-std::optional<Player> check_for_winner(const Board& board)
-{
-    std::optional<Player> winner = std::nullopt;
-    // Columns
-    for (int x = 0; x < board.width() && !winner.has_value(); ++x) {
-        winner = check_for_winner_on_line(board, [x](int position) {
-            return CellIndex{x, position};
-        });
-    }
-    // Rows
-    for (int y = 0; y < board.height() && !winner.has_value(); ++y) {
-        winner = check_for_winner_on_line(board, [y](int position) {
-            return CellIndex{position, y};
-        });
-    }
-    // Diagonal
-    if (!winner.has_value()) {
-        winner = check_for_winner_on_line(board, [](int position) {
-            return CellIndex{position, position};
-        });
-    }
-    // Anti-diagonal
-    if (!winner.has_value()) {
-        winner = check_for_winner_on_line(board, [&](int position) {
-            return CellIndex{position, board.height() - position - 1};
-        });
+/// Remembers what the last frame depended on, so that we only draw when something has changed
+/// (the window keeps showing what we drew during the previous frames)
+class FrameCache {
+public:
+    /// Must be called whenever the board is modified
+    void invalidate() { _is_up_to_date = false; }
+
+    /// Returns true iff the frame needs to be drawn again
+    bool needs_redraw(Player current_player, std::optional<CellIndex> hovered_cell)
+    {
+        const bool needs_redraw = !_is_up_to_date ||
+                                  current_player != _current_player ||
+                                  hovered_cell != _hovered_cell;
+        _is_up_to_date  = true;
+        _current_player = current_player;
+        _hovered_cell   = hovered_cell;
+        return needs_redraw;
     }
-    return winner;
+
+private:
+    bool                     _is_up_to_date{false};
+    Player                   _current_player{};
+    std::optional<CellIndex> _hovered_cell{};
+};
+
+template<typename GameRules>
+std::optional<Player> check_for_winner(const BoardFor<GameRules>& board)
+{
+    return GameRules::winner(board, Player::Crosses, Player::Noughts);
 }
 
-bool game_is_finished(const Board& board)
+template<typename GameRules>
+bool game_is_finished(const BoardFor<GameRules>& board)
 {
-    if (const auto winner = check_for_winner(board); winner.has_value()) {
+    if (const auto winner = check_for_winner<GameRules>(board); winner.has_value()) {
         if (*winner == Player::Noughts) {
             std::cout << "Noughts have won!\n";
         }
@@ -168,26 +179,133 @@ bool game_is_finished(const Board& board)
     }
 }
 
-void play_noughts_and_crosses()
+/// Looks up in the tablebase who wins if both players play perfectly from now on
+template<typename GameRules>
+void show_perfect_play_result(const BoardFor<GameRules>& board, Player current_player, const Tablebase& tablebase)
 {
-    auto board          = Board{};
-    auto current_player = Player::Crosses;
-    auto ctx            = p6::Context{{800, 800, "Noughts and Crosses"}};
+    if (check_for_winner<GameRules>(board).has_value() || board_is_full(board)) {
+        return;
+    }
+    const auto* const player_name = current_player == Player::Noughts ? "Noughts" : "Crosses";
+    switch (tablebase.result(MnkGame<GameRules>::index_of(board, Player::Crosses))) { // Crosses always start
+    case GameResult::Win: std::cout << player_name << " can force a win\n"; break;
+    case GameResult::Loss: std::cout << player_name << " will lose against perfect play\n"; break;
+    case GameResult::Draw: std::cout << "This is a draw with perfect play\n"; break;
+    case GameResult::Unknown: break;
+    }
+}
+
+template<typename GameRules>
+void play_noughts_and_crosses_with(const char* title, std::string_view tablebase_file)
+{
+    auto       board          = BoardFor<GameRules>{};
+    auto       current_player = Player::Crosses;
+    auto       frame_cache    = FrameCache{};
+    const auto tablebase      = Tablebase::open(tablebase_file, MnkGame<GameRules>::positions_count);
+    auto       ctx            = p6::Context{{800, 800, title}};
 
     ctx.mouse_pressed = [&](p6::MouseButton event) {
-        try_to_play(cell_hovered_by(event.position, board.height()), board, current_player);
+        if (try_to_play<GameRules>(cell_hovered_by(event.position, board.size()), board, current_player)) {
+            frame_cache.invalidate();
+            if (tablebase.has_value()) {
+                show_perfect_play_result<GameRules>(board, current_player, *tablebase);
+            }
+        }
     };
     ctx.update = [&]() {
-        ctx.background({.3f, 0.25f, 0.35f});
-        ctx.stroke_weight = 0.01f;
-        ctx.stroke        = {1.f, 1.f, 1.f, 1.f};
-        ctx.fill          = {0.f, 0.f, 0.f, 0.f};
-        draw_board(board.height(), ctx);
-        draw_noughts_and_crosses(board, ctx);
-        try_draw_player_on_hovered_cell(current_player, board, ctx);
-        if (game_is_finished(board)) {
+        const auto hovered_cell = cell_hovered_by(ctx.mouse(), board.size());
+        if (!frame_cache.needs_redraw(current_player, hovered_cell)) {
+            return;
+        }
+        draw_frame<GameRules>(board, current_player, hovered_cell, ctx);
+        if (game_is_finished<GameRules>(board)) {
+            ctx.stop();
+        }
+    };
+    ctx.start();
+}
+
+void play_noughts_and_crosses()
+{
+    play_noughts_and_crosses_with<NoughtsAndCrossesRules>("Noughts and Crosses", noughts_and_crosses_tablebase_file);
+}
+
+void play_misere_noughts_and_crosses()
+{
+    play_noughts_and_crosses_with<MisereNoughtsAndCrossesRules>("Misere Noughts and Crosses", misere_noughts_and_crosses_tablebase_file);
+}
+
+void play_gravity_noughts_and_crosses()
+{
+    play_noughts_and_crosses_with<GravityNoughtsAndCrossesRules>("Gravity Noughts and Crosses", gravity_noughts_and_crosses_tablebase_file);
+}
+
+/// The render path as it was before it used const references and the FrameCache,
+/// kept to measure the difference in benchmark_noughts_and_crosses_rendering()
+template<typename BoardType>
+void draw_frame_without_cache(Player current_player, BoardType board, p6::Context& ctx)
+{
+    ctx.background({.3f, 0.25f, 0.35f});
+    ctx.stroke_weight = 0.01f;
+    ctx.stroke        = {1.f, 1.f, 1.f, 1.f};
+    ctx.fill          = {0.f, 0.f, 0.f, 0.f};
+    draw_board(board.size(), ctx);
+    for (int x = 0; x < board.width(); ++x) {
+        for (int y = 0; y < board.height(); ++y) {
+            const auto cell = board[{x, y}];
+            if (cell.has_value()) {
+                draw_player(*cell, {x, y}, board.size(), ctx);
+            }
+        }
+    }
+    const auto hovered_cell = cell_hovered_by(ctx.mouse(), board.size());
+    if (hovered_cell.has_value() && !board[*hovered_cell].has_value()) {
+        draw_player(current_player, *hovered_cell, board.size(), ctx);
+    }
+}
+
+void benchmark_noughts_and_crosses_rendering()
+{
+    using LargeBoardRules = Rules<100, 100, 5>; // The render path doesn't depend on the number of marks you need to align, only on the size of the board
+    using LargeBoard      = BoardFor<LargeBoardRules>;
+    static constexpr int frames_per_phase = 300;
+
+    auto board          = std::make_unique<LargeBoard>();
+    auto current_player = Player::Crosses;
+    for (int i = 0; i < board->width() * board->height() / 2; ++i) {
+        try_to_play<LargeBoardRules>(CellIndex{rand(0, board->width() - 1), rand(0, board->height() - 1)}, *board, current_player);
+    }
+    auto frame_cache = FrameCache{};
+    auto cpu_times   = std::array<std::chrono::nanoseconds, 3>{};
+    int  frame       = 0;
+    auto ctx         = p6::Context{{800, 800, "Noughts and Crosses rendering benchmark"}};
+    ctx.update       = [&]() {
+        const int  phase = frame / frames_per_phase;
+        const auto begin = std::chrono::steady_clock::now();
+        if (phase == 0) {
+            draw_frame_without_cache(current_player, *board, ctx);
+        }
+        else {
+            if (phase == 2 && try_to_play<LargeBoardRules>(CellIndex{rand(0, board->width() - 1), rand(0, board->height() - 1)}, *board, current_player)) { // The board changes on most frames
+                frame_cache.invalidate();
+            }
+            const auto hovered_cell = cell_hovered_by(ctx.mouse(), board->size());
+            if (frame_cache.needs_redraw(current_player, hovered_cell)) {
+                draw_frame<LargeBoardRules>(*board, current_player, hovered_cell, ctx);
+            }
+        }
+        cpu_times[static_cast<size_t>(phase)] += std::chrono::steady_clock::now() - begin;
+        if (++frame == frames_per_phase * 3) {
             ctx.stop();
         }
     };
     ctx.start();
+
+    const auto show_time_per_frame = [&](const char* name, std::chrono::nanoseconds cpu_time) {
+        std::cout << name << ": " << std::chrono::duration<double, std::micro>{cpu_time}.count() / frames_per_phase << " us of CPU time per frame\n";
+    };
+    std::cout << "Board of " << board->width() << "x" << board->height() << " cells, " << frames_per_phase << " frames per measure\n";
+    show_time_per_frame("Before (copies, no frame skipping)     ", cpu_times[0]);
+    show_time_per_frame("After, when the board doesn't change   ", cpu_times[1]);
+    show_time_per_frame("After, when the board changes each frame", cpu_times[2]);
 }
\ No newline at end of file
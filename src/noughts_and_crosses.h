@@ -1,3 +1,30 @@
 #pragma once
+#include <optional>
+#include <string_view>
+#include "board.h"
+#include "game_rules.h"
 
-void play_noughts_and_crosses();
\ No newline at end of file
+void play_noughts_and_crosses();
+void play_misere_noughts_and_crosses();
+void play_gravity_noughts_and_crosses();
+
+using NoughtsAndCrossesRules        = Rules<3, 3, 3>;
+using MisereNoughtsAndCrossesRules  = Rules<3, 3, 3, PlaceAnywhere, Misere>;
+using GravityNoughtsAndCrossesRules = Rules<3, 3, 3, DropInColumn>;
+
+/// When these tablebases exist (see the build-tablebase tool), the games tell who can win with perfect play
+inline constexpr std::string_view noughts_and_crosses_tablebase_file         = "noughts_and_crosses.tablebase";
+inline constexpr std::string_view misere_noughts_and_crosses_tablebase_file  = "misere_noughts_and_crosses.tablebase";
+inline constexpr std::string_view gravity_noughts_and_crosses_tablebase_file = "gravity_noughts_and_crosses.tablebase";
+
+/// Measures the CPU time spent drawing each frame of a large board, with and without the frame skipping
+void benchmark_noughts_and_crosses_rendering();
+
+/// Draws a nought in the cell at `index`
+void draw_nought(CellIndex index, BoardSize board_size, p6::Context& ctx);
+
+/// Draws a cross in the cell at `index`
+void draw_cross(CellIndex index, BoardSize board_size, p6::Context& ctx);
+
+/// Returns the cell of the board that is under `position`, if any
+std::optional<CellIndex> cell_hovered_by(glm::vec2 position, BoardSize board_size);
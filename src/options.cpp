@@ -0,0 +1,33 @@
+#include "options.h"
+#include <map>
+
+static std::map<std::string_view, std::string_view>& options()
+{
+    static auto options = std::map<std::string_view, std::string_view>{};
+    return options;
+}
+
+std::vector<std::string_view> parse_options(const std::vector<std::string_view>& arguments)
+{
+    auto remaining_arguments = std::vector<std::string_view>{};
+    for (size_t i = 0; i < arguments.size(); ++i) {
+        const auto argument = arguments[i];
+        if (argument.substr(0, 2) == "--" && i + 1 < arguments.size()) {
+            options()[argument.substr(2)] = arguments[i + 1];
+            i++;
+        }
+        else {
+            remaining_arguments.push_back(argument);
+        }
+    }
+    return remaining_arguments;
+}
+
+std::optional<std::string_view> option(std::string_view name)
+{
+    const auto value = options().find(name);
+    if (value == options().end()) {
+        return std::nullopt;
+    }
+    return std::make_optional(value->second);
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include <optional>
+#include <string_view>
+#include <vector>
+
+/// Reads the options given as `--name value` on the command line and removes them from `arguments`
+/// The arguments must live until the end of the program (which is the case of the ones of main())
+/// Returns the remaining arguments
+std::vector<std::string_view> parse_options(const std::vector<std::string_view>& arguments);
+
+/// Returns the value of the option `--name`, if it has been given on the command line
+std::optional<std::string_view> option(std::string_view name);
@@ -0,0 +1,260 @@
+#include "pattern_index.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "rand.h"
+
+PatternIndex::PatternIndex(const Dictionary& dictionary)
+    : _dictionary{dictionary}
+    , _words_by_length(dictionary.max_length() + 1)
+{
+    for (size_t length = 1; length < _words_by_length.size(); ++length) {
+        const auto& words   = dictionary.words_with_length(length);
+        auto&       indexed = _words_by_length[length];
+        indexed.letters.reserve(words.size());
+        // Counts the words of each list, then turns the counts into the beginning of each list, and fills the lists.
+        // Since the words are visited in order, the lists end up sorted.
+        indexed.postings_begin.assign(length * 26 + 1, 0);
+        for (const auto word : words) {
+            indexed.letters.push_back(letters_of(word));
+            for (size_t position = 0; position < length; ++position) {
+                indexed.postings_begin[position * 26 + static_cast<size_t>(word[position] - 'a') + 1]++;
+            }
+        }
+        for (size_t list = 1; list < indexed.postings_begin.size(); ++list) {
+            indexed.postings_begin[list] += indexed.postings_begin[list - 1];
+        }
+        indexed.postings.resize(indexed.postings_begin.back());
+        auto next_in_list = indexed.postings_begin;
+        for (size_t word = 0; word < words.size(); ++word) {
+            for (size_t position = 0; position < length; ++position) {
+                indexed.postings[next_in_list[position * 26 + static_cast<size_t>(words[word][position] - 'a')]++] = static_cast<uint32_t>(word);
+            }
+        }
+    }
+}
+
+/// The letters that are revealed in `pattern`, or std::nullopt if `pattern` contains something else than '_' and letters from 'a' to 'z'
+static std::optional<LetterMask> revealed_letters_of(std::string_view pattern)
+{
+    LetterMask revealed_letters = 0;
+    for (const char letter : pattern) {
+        if (is_lowercase_letter(letter)) {
+            revealed_letters |= letter_bit(letter);
+        }
+        else if (letter != '_') {
+            return std::nullopt;
+        }
+    }
+    return std::make_optional(revealed_letters);
+}
+
+/// Checks the hidden positions of `word`, which must have the revealed letters of `pattern` and none of the excluded letters
+static bool hidden_letters_match(std::string_view word, std::string_view pattern, LetterMask revealed_letters)
+{
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        if (pattern[i] == '_' && (revealed_letters & letter_bit(word[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Returns the first element of the sorted range [`begin`, `end`) that is not less than `value`
+/// Looks at `begin + 1`, `begin + 2`, `begin + 4`, etc. before doing a binary search, so that it is fast both when the value is close,
+/// which is the case when we intersect lists of similar sizes, and when it is far, which is the case when one list is a lot longer.
+static const uint32_t* gallop_to(uint32_t value, const uint32_t* begin, const uint32_t* end)
+{
+    ptrdiff_t step = 1;
+    while (begin + step < end && begin[step] < value) {
+        begin += step;
+        step *= 2;
+    }
+    return std::lower_bound(begin, std::min(begin + step + 1, end), value);
+}
+
+std::vector<std::string_view> PatternIndex::words_matching(std::string_view pattern, LetterMask excluded_letters) const
+{
+    const auto revealed_letters = revealed_letters_of(pattern);
+    if (!revealed_letters.has_value() || pattern.size() >= _words_by_length.size()) {
+        return {};
+    }
+    const auto& words   = _dictionary.words_with_length(pattern.size());
+    const auto& indexed = _words_by_length[pattern.size()];
+
+    using PostingList = std::pair<const uint32_t*, const uint32_t*>;
+    auto lists        = std::vector<PostingList>{};
+    for (size_t position = 0; position < pattern.size(); ++position) {
+        if (pattern[position] != '_') {
+            const auto list = position * 26 + static_cast<size_t>(pattern[position] - 'a');
+            lists.emplace_back(indexed.postings.data() + indexed.postings_begin[list], indexed.postings.data() + indexed.postings_begin[list + 1]);
+        }
+    }
+
+    auto candidates = std::vector<uint32_t>{};
+    if (lists.empty()) {
+        candidates.resize(words.size());
+        for (uint32_t word = 0; word < candidates.size(); ++word) {
+            candidates[word] = word;
+        }
+    }
+    else {
+        std::sort(lists.begin(), lists.end(), [](const PostingList& a, const PostingList& b) {
+            return a.second - a.first < b.second - b.first;
+        });
+        candidates.assign(lists.front().first, lists.front().second);
+        for (auto list = lists.begin() + 1; list != lists.end() && !candidates.empty(); ++list) {
+            auto kept        = candidates.begin();
+            auto search_from = list->first;
+            for (const auto candidate : candidates) {
+                search_from = gallop_to(candidate, search_from, list->second);
+                if (search_from == list->second) {
+                    break;
+                }
+                if (*search_from == candidate) {
+                    *kept++ = candidate;
+                }
+            }
+            candidates.erase(kept, candidates.end());
+        }
+    }
+
+    auto matches = std::vector<std::string_view>{};
+    for (const auto candidate : candidates) {
+        if (!(indexed.letters[candidate] & excluded_letters) && hidden_letters_match(words[candidate], pattern, *revealed_letters)) {
+            matches.push_back(words[candidate]);
+        }
+    }
+    return matches;
+}
+
+std::vector<std::string_view> words_matching_by_linear_scan(const Dictionary& dictionary, std::string_view pattern, LetterMask excluded_letters)
+{
+    const auto revealed_letters = revealed_letters_of(pattern);
+    if (!revealed_letters.has_value()) {
+        return {};
+    }
+    auto matches = std::vector<std::string_view>{};
+    for (const auto word : dictionary.words_with_length(pattern.size())) {
+        bool word_matches = true;
+        for (size_t i = 0; i < pattern.size() && word_matches; ++i) {
+            word_matches = pattern[i] == '_' ? !(letter_bit(word[i]) & *revealed_letters)
+                                             : word[i] == pattern[i];
+        }
+        if (word_matches && !(letters_of(word) & excluded_letters)) {
+            matches.push_back(word);
+        }
+    }
+    return matches;
+}
+
+/// Writes `words_count` random words to `path`, whose letters are drawn with their frequency in English
+/// so that the lists of the index are as unbalanced as with a real dictionary
+static void write_random_dictionary(const std::filesystem::path& path, int words_count)
+{
+    static constexpr std::array<int, 26> letter_frequencies = {82, 15, 28, 43, 127, 22, 20, 61, 70, 2, 8, 40, 24, 67, 75, 19, 1, 60, 63, 91, 28, 10, 24, 2, 20, 1};
+    auto                                 letters            = std::string{};
+    for (size_t letter = 0; letter < letter_frequencies.size(); ++letter) {
+        letters.append(static_cast<size_t>(letter_frequencies[letter]), static_cast<char>('a' + letter));
+    }
+    auto file = std::ofstream{path, std::ios::binary};
+    auto word = std::string{};
+    for (int i = 0; i < words_count; ++i) {
+        word.resize(static_cast<size_t>(rand(4, 12)));
+        for (auto& letter : word) {
+            letter = letters[rand<size_t>(0, letters.size() - 1)];
+        }
+        file << word << '\n';
+    }
+}
+
+struct PatternQuery {
+    std::string pattern;
+    LetterMask  excluded_letters;
+};
+
+/// A query that a hangman player could make while guessing `word`: two of its letters have been revealed, and three letters were misses
+static PatternQuery random_query_for(std::string_view word)
+{
+    auto query = PatternQuery{std::string(word.size(), '_'), 0};
+    for (int i = 0; i < 2; ++i) {
+        const char revealed_letter = word[rand<size_t>(0, word.size() - 1)];
+        for (size_t position = 0; position < word.size(); ++position) {
+            if (word[position] == revealed_letter) {
+                query.pattern[position] = revealed_letter;
+            }
+        }
+    }
+    const auto letters = letters_of(word);
+    for (int misses_count = 0; misses_count < 3;) {
+        const auto miss = letter_bit(static_cast<char>('a' + rand(0, 25)));
+        if (!(letters & miss) && !(query.excluded_letters & miss)) {
+            query.excluded_letters |= miss;
+            misses_count++;
+        }
+    }
+    return query;
+}
+
+int benchmark_pattern_index(const std::vector<std::string_view>&)
+{
+    static constexpr int queries_count = 1000;
+
+    const auto path = std::filesystem::temp_directory_path() / "pattern_index_benchmark_dictionary.txt";
+    // The dictionaries are closed before the file is removed, whether the benchmark succeeds or not
+    const bool success = [&]() {
+        for (const int words_count : {100'000, 300'000, 1'000'000}) {
+            write_random_dictionary(path, words_count);
+            const auto dictionary = Dictionary::open(path);
+            if (!dictionary.has_value()) {
+                std::cout << "Could not write \"" << path.string() << "\"\n";
+                return false;
+            }
+            const auto index_begin = std::chrono::steady_clock::now();
+            const auto index       = PatternIndex{*dictionary};
+            const auto index_end   = std::chrono::steady_clock::now();
+
+            auto queries = std::vector<PatternQuery>{};
+            for (int i = 0; i < queries_count; ++i) {
+                queries.push_back(random_query_for(dictionary->random_word()));
+            }
+            const auto measure = [&](auto&& words_matching) {
+                size_t     matches_count = 0;
+                const auto begin         = std::chrono::steady_clock::now();
+                for (const auto& query : queries) {
+                    matches_count += words_matching(query).size();
+                }
+                const auto end = std::chrono::steady_clock::now();
+                return std::make_pair(std::chrono::duration<double, std::micro>{end - begin}.count() / queries_count, matches_count);
+            };
+            const auto [index_time, index_matches] = measure([&](const PatternQuery& query) {
+                return index.words_matching(query.pattern, query.excluded_letters);
+            });
+            const auto [scan_time, scan_matches] = measure([&](const PatternQuery& query) {
+                return words_matching_by_linear_scan(*dictionary, query.pattern, query.excluded_letters);
+            });
+
+            std::cout << words_count << " words (index built in " << std::chrono::duration<double, std::milli>{index_end - index_begin}.count() << "ms): "
+                      << index_time << " us per query with the index, " << scan_time << " us with a linear scan, "
+                      << static_cast<double>(scan_matches) / queries_count << " matches on average\n";
+            // The words found by the index and by the linear scan are compared out of the measures, since it needs sorting them
+            for (const auto& query : queries) {
+                auto index_words = index.words_matching(query.pattern, query.excluded_letters);
+                auto scan_words  = words_matching_by_linear_scan(*dictionary, query.pattern, query.excluded_letters);
+                std::sort(index_words.begin(), index_words.end());
+                std::sort(scan_words.begin(), scan_words.end());
+                if (index_words != scan_words) {
+                    std::cout << "The index and the linear scan found different words for the pattern \"" << query.pattern << "\"!\n";
+                    return false;
+                }
+            }
+        }
+        return true;
+    }();
+    std::filesystem::remove(path);
+    return success ? 0 : 1;
+}
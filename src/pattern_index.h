@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "dictionary.h"
+#include "word_with_missing_letters.h"
+
+/// Finds the words of a Dictionary that match a hangman pattern like "_o_e", without looking at all the words of that length.
+/// For each length, position and letter, the index stores the sorted list of the words that have that letter at that position.
+/// A query intersects the lists of the revealed letters, starting with the shortest one, and only checks the few words that remain.
+class PatternIndex {
+public:
+    /// `dictionary` must outlive the index
+    explicit PatternIndex(const Dictionary& dictionary);
+
+    /// Returns the words that match `pattern`, where '_' is a letter that hasn't been revealed yet, and that contain none of the `excluded_letters`
+    /// Like in hangman, a letter that has been revealed is revealed at all its positions, so it can't be under a '_'.
+    std::vector<std::string_view> words_matching(std::string_view pattern, LetterMask excluded_letters) const;
+
+private:
+    /// The words of one length. The list of the words that have `letter` at `position` is
+    /// `postings[postings_begin[position * 26 + letter]]` to `postings[postings_begin[position * 26 + letter + 1]]`
+    struct WordsOfLength {
+        std::vector<LetterMask> letters; // The letters of each word
+        std::vector<uint32_t>   postings_begin;
+        std::vector<uint32_t>   postings; // The indices of the words in Dictionary::words_with_length()
+    };
+
+    const Dictionary&          _dictionary;
+    std::vector<WordsOfLength> _words_by_length;
+};
+
+/// The reference that PatternIndex is compared to: goes through all the words that have the length of the pattern
+std::vector<std::string_view> words_matching_by_linear_scan(const Dictionary& dictionary, std::string_view pattern, LetterMask excluded_letters);
+
+/// Compares PatternIndex with a linear scan on dictionaries of 100k to 1M random words
+int benchmark_pattern_index(const std::vector<std::string_view>& arguments);
@@ -1,28 +1,249 @@
 #include "play_guess_the_number.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <functional>
 #include <iostream>
+#include <limits>
 #include "get_input_from_user.h"
+#include "input_reactor.h"
+#include "options.h"
 #include "rand.h"
+#include "screen.h"
+#include "session.h"
 
-void play_guess_the_number()
+/// The user, who types the guesses in the console and sees the feedback
+struct HumanGuesser {
+    int guess() const { return get_input_from_user<int>(); }
+
+    void learn(int, GuessFeedback feedback) const
+    {
+        if (feedback == GuessFeedback::Greater) {
+            std::cout << "Greater\n";
+        }
+        else if (feedback == GuessFeedback::Smaller) {
+            std::cout << "Smaller\n";
+        }
+        else {
+            std::cout << "Congrats, you won!\n";
+        }
+    }
+};
+
+GameTask guess_the_number_game(SessionInputs& inputs, Screen& screen)
 {
     // Pick a random number
     static constexpr int MIN             = 0;   // `static constexpr` is the "proper" way of declaring constants known at compile time
     static constexpr int MAX             = 100; // It is as efficient as `#define` but has the benefit of working like a normal C++ variable: it has a type, etc.
     const int            number_to_guess = rand(MIN, MAX);
-    std::cout << "I picked a number between " << MIN << " and " << MAX << '\n';
-    // Ask the user for a guess
-    bool finished = false;
-    while (!finished) {
-        const int user_guess = get_input_from_user<int>();
-        if (user_guess < number_to_guess) {
-            std::cout << "Greater\n";
+    screen << "I picked a number between " << MIN << " and " << MAX << '\n';
+    // Ask the user for guesses until they find it
+    int guesses_count = 0;
+    while (true) {
+        const int user_guess = co_await inputs.next<int>();
+        guesses_count++;
+        const auto feedback = HonestOracle<int>{number_to_guess}.answer(user_guess);
+        if (feedback == GuessFeedback::Greater) {
+            screen << "Greater\n";
         }
-        else if (user_guess > number_to_guess) {
-            std::cout << "Smaller\n";
+        else if (feedback == GuessFeedback::Smaller) {
+            screen << "Smaller\n";
         }
         else {
-            std::cout << "Congrats, you won!\n";
-            finished = true;
+            screen << "Congrats, you won in " << guesses_count << " guesses!\n";
+            co_return;
+        }
+    }
+}
+
+void play_guess_the_number()
+{
+    auto       inputs = SessionInputs{};
+    auto       screen = Screen{};
+    const auto game   = guess_the_number_game(inputs, screen);
+    play_until_over(game, inputs, screen);
+}
+
+void play_liar_guess_the_number()
+{
+    static constexpr int  MIN       = 0;
+    static constexpr int  MAX       = 100;
+    static constexpr auto lie_model = LieModel{0.2, 2};
+    std::cout << "I picked a number between " << MIN << " and " << MAX << ", but I may lie up to " << *lie_model.max_lies << " times when I tell you if it is greater or smaller\n";
+    play_guess_the_number_round(HumanGuesser{}, LyingOracle<int>{rand(MIN, MAX), lie_model});
+}
+
+void play_guess_the_number_sessions()
+{
+    static constexpr size_t sessions_count = 3;
+    static constexpr auto   reminder_delay = std::chrono::seconds{20};
+
+    auto reactor = InputReactor{session_input()};
+    auto screens = ScreenMultiplexer{};
+    auto inputs  = std::vector<SessionInputs>(sessions_count);
+    auto games   = std::vector<GameTask>{};
+    screens.screen(sessions_count - 1); // Creates all the screens before the games keep references to them
+    screens.shared_screen() << "Start each guess with the number of its game, e.g. \"0 50\" for game 0\n";
+    for (size_t session = 0; session < sessions_count; ++session) {
+        games.push_back(guess_the_number_game(inputs[session], screens.screen(session)));
+    }
+    screens.present();
+
+    // Each game is suspended while it waits for a guess, and the reactor resumes it when it gets one, so that the other games can be played in the meantime
+    size_t                      sessions_left  = sessions_count;
+    std::function<void(size_t)> wait_for_guess = [&](size_t session) {
+        reactor.read_line(session, [&, session](std::string_view line) {
+            if (!inputs[session].give(line)) {
+                return false;
+            }
+            if (games[session].is_over()) {
+                sessions_left--;
+            }
+            else {
+                wait_for_guess(session);
+            }
+            screens.present();
+            return true;
+        });
+    };
+    for (size_t session = 0; session < sessions_count; ++session) {
+        wait_for_guess(session);
+    }
+
+    // The thread is not blocked while the players think, so it can remind them that some games are not over
+    std::function<void()> remind = [&]() {
+        screens.shared_screen() << sessions_left << " game(s) are still waiting for a guess\n";
+        screens.present();
+        reactor.after(reminder_delay, remind);
+    };
+    reactor.after(reminder_delay, remind);
+    reactor.run();
+}
+
+/// Plays `rounds_count` rounds with `play_round`, which returns the number of guesses of a round, and shows the statistics of the rounds
+template<typename PlayRound>
+void simulate_rounds(size_t rounds_count, std::string_view range_name, PlayRound&& play_round)
+{
+    auto       rounds_by_guesses_count = std::vector<size_t>{};
+    const auto begin                   = std::chrono::steady_clock::now();
+    for (size_t round = 0; round < rounds_count; ++round) {
+        const auto guesses_count = static_cast<size_t>(play_round());
+        if (guesses_count >= rounds_by_guesses_count.size()) {
+            rounds_by_guesses_count.resize(guesses_count + 1);
+        }
+        rounds_by_guesses_count[guesses_count]++;
+    }
+    const auto seconds = std::chrono::duration<double>{std::chrono::steady_clock::now() - begin}.count();
+
+    size_t guesses_count = 0;
+    for (size_t count = 0; count < rounds_by_guesses_count.size(); ++count) {
+        guesses_count += count * rounds_by_guesses_count[count];
+    }
+    std::cout << "Played " << rounds_count << " rounds with numbers " << range_name << " in " << seconds << "s: "
+              << static_cast<double>(rounds_count) / seconds / 1e6 << " million rounds per second, "
+              << static_cast<double>(guesses_count) / static_cast<double>(rounds_count) << " guesses per round on average\n"
+              << "Guesses per round:\n";
+    for (size_t count = 0; count < rounds_by_guesses_count.size(); ++count) {
+        if (rounds_by_guesses_count[count] != 0) {
+            std::cout << "  " << count << ": " << rounds_by_guesses_count[count]
+                      << " (" << 100. * static_cast<double>(rounds_by_guesses_count[count]) / static_cast<double>(rounds_count) << "%)\n";
+        }
+    }
+}
+
+/// Calls `simulate(min, max, name)` with the bounds of `range` ("100", "64" or "128"), which can be of different types
+/// Returns false if the range is unknown.
+template<typename Simulate>
+bool simulate_in_range(std::string_view range, Simulate&& simulate)
+{
+    if (range == "100") {
+        simulate(0, 100, "between 0 and 100");
+    }
+    else if (range == "64") {
+        simulate(uint64_t{0}, std::numeric_limits<uint64_t>::max(), "of 64 bits");
+    }
+#if defined(__SIZEOF_INT128__)
+    else if (range == "128") {
+        simulate(uint128{0}, static_cast<uint128>(-1), "of 128 bits");
+    }
+#endif
+    else {
+        std::cout << "Unknown range \"" << range << "\", it must be 100, 64 or 128 (if the compiler has 128 bit integers)\n";
+        return false;
+    }
+    return true;
+}
+
+int simulate_guess_the_number(const std::vector<std::string_view>& arguments)
+{
+    const auto rounds_count_argument = arguments.empty() ? std::nullopt : parse_input<size_t>(arguments[0]);
+    if (rounds_count_argument.value_or(0) == 0) {
+        std::cout << "Usage: simulate-guess-the-number <number of rounds, at least 1> [100 | 64 | 128]\n";
+        return 1;
+    }
+    const auto rounds_count = *rounds_count_argument;
+    const auto range   = arguments.size() > 1 ? arguments[1] : std::string_view{"100"};
+    const bool success = simulate_in_range(range, [&](auto min, auto max, std::string_view range_name) {
+        using Integer = decltype(min);
+        simulate_rounds(rounds_count, range_name, [&]() {
+            return play_guess_the_number_round(BisectionBot<Integer>{min, max}, HonestOracle<Integer>{rand(min, max)});
+        });
+    });
+    return success ? 0 : 1;
+}
+
+int simulate_liar_guess_the_number(const std::vector<std::string_view>& arguments)
+{
+    const auto show_usage = []() {
+        std::cout << "Usage: simulate-liar-guess-the-number <number of rounds, at least 1> [100 | 64 | 128] [--lie-probability <p, at least 0 and below 0.5>] [--max-lies <k, at least 0>]\n";
+        return 1;
+    };
+    const auto rounds_count_argument = arguments.empty() ? std::nullopt : parse_input<size_t>(arguments[0]);
+    if (rounds_count_argument.value_or(0) == 0) {
+        return show_usage();
+    }
+    const auto rounds_count = *rounds_count_argument;
+    auto       lie_model    = LieModel{0.1, std::nullopt};
+    if (const auto probability = option("lie-probability"); probability.has_value()) {
+        const auto result = std::from_chars(probability->data(), probability->data() + probability->size(), lie_model.probability);
+        // From 0.5 on, the answers don't tell anything about the number, and the solver would never find it
+        if (result.ec != std::errc{} || result.ptr != probability->data() + probability->size() || !(0. <= lie_model.probability && lie_model.probability < 0.5)) {
+            return show_usage();
+        }
+    }
+    if (const auto max_lies = option("max-lies"); max_lies.has_value()) {
+        lie_model.max_lies = parse_input<int>(*max_lies);
+        if (lie_model.max_lies.value_or(-1) < 0) {
+            return show_usage();
+        }
+    }
+
+    size_t     max_intervals_count = 0;
+    const auto range               = arguments.size() > 1 ? arguments[1] : std::string_view{"100"};
+    const bool success             = simulate_in_range(range, [&](auto min, auto max, std::string_view range_name) {
+        using Integer = decltype(min);
+        simulate_rounds(rounds_count, range_name, [&]() {
+            auto solver        = LiarSolver<Integer>{min, max, lie_model};
+            auto oracle        = LyingOracle<Integer>{rand(min, max), lie_model};
+            int  guesses_count = 0;
+            while (true) {
+                const auto guess    = solver.guess();
+                const auto feedback = oracle.answer(guess);
+                guesses_count++;
+                solver.learn(guess, feedback);
+                max_intervals_count = std::max(max_intervals_count, solver.intervals_count());
+                if (feedback == GuessFeedback::Correct) {
+                    return guesses_count;
+                }
+            }
+        });
+    });
+    if (success) {
+        std::cout << "The oracle lied with a probability of " << lie_model.probability;
+        if (lie_model.max_lies.has_value()) {
+            std::cout << ", at most " << *lie_model.max_lies << " times per round";
         }
+        std::cout << "\nThe probabilities of the numbers took at most " << max_intervals_count << " intervals\n";
     }
+    return success ? 0 : 1;
 }
\ No newline at end of file
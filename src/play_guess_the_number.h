@@ -1,3 +1,262 @@
 #pragma once
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <string_view>
+#include <vector>
+#include "game_coroutine.h"
+#include "rand.h"
 
-void play_guess_the_number();
\ No newline at end of file
+/// What the game answers to a guess
+enum class GuessFeedback {
+    Greater, // The number to guess is greater than the guess
+    Smaller, // The number to guess is smaller than the guess
+    Correct,
+};
+
+/// Answers the guesses about `number`, like the game does
+template<typename Integer>
+struct HonestOracle {
+    Integer number;
+
+    GuessFeedback answer(Integer guess) const
+    {
+        return guess < number   ? GuessFeedback::Greater
+               : guess > number ? GuessFeedback::Smaller
+                                : GuessFeedback::Correct;
+    }
+};
+
+/// How the oracle of the liar variant lies: on each wrong guess, it gives the opposite direction with `probability`, which must be below 0.5
+/// It never lies when the guess is correct, so that the round ends once the number is found.
+struct LieModel {
+    double             probability;
+    std::optional<int> max_lies; // At most this number of lies in a round (Ulam's game), when given
+};
+
+/// Answers the guesses about `number`, but lies as `model` allows
+template<typename Integer>
+class LyingOracle {
+public:
+    LyingOracle(Integer number, LieModel model)
+        : _number{number}
+        , _model{model}
+    {
+    }
+
+    GuessFeedback answer(Integer guess)
+    {
+        const auto truth = HonestOracle<Integer>{_number}.answer(guess);
+        if (truth == GuessFeedback::Correct
+            || (_model.max_lies.has_value() && _lies_count >= *_model.max_lies)
+            || rand(0., 1.) >= _model.probability) {
+            return truth;
+        }
+        _lies_count++;
+        return truth == GuessFeedback::Greater ? GuessFeedback::Smaller : GuessFeedback::Greater;
+    }
+
+private:
+    Integer  _number;
+    LieModel _model;
+    int      _lies_count{0};
+};
+
+/// Asks `player` for guesses until `oracle` answers that one is correct, and gives it the answer to each of them
+/// `player` must have `Integer guess()` and `void learn(Integer guess, GuessFeedback feedback)`, and `oracle` must have `GuessFeedback answer(Integer guess)`.
+/// Returns the number of guesses.
+template<typename Player, typename Oracle>
+int play_guess_the_number_round(Player&& player, Oracle&& oracle)
+{
+    int guesses_count = 0;
+    while (true) {
+        const auto guess = player.guess();
+        guesses_count++;
+        const auto feedback = oracle.answer(guess);
+        player.learn(guess, feedback);
+        if (feedback == GuessFeedback::Correct) {
+            return guesses_count;
+        }
+    }
+}
+
+/// Plays guess the number optimally: each guess is in the middle of the numbers that are still possible, and halves them,
+/// so that it finds a number among N in at most ceil(log2(N + 1)) guesses, which no other strategy can do
+template<typename Integer>
+class BisectionBot {
+public:
+    BisectionBot(Integer min, Integer max)
+        : _min{min}
+        , _max{max}
+    {
+    }
+
+    Integer guess() const
+    {
+        // The difference is computed without sign, so that it doesn't overflow even when the range covers all the values of Integer
+        using Unsigned = typename UnsignedOf<Integer>::type;
+        return static_cast<Integer>(static_cast<Unsigned>(_min) + (static_cast<Unsigned>(_max) - static_cast<Unsigned>(_min)) / 2);
+    }
+
+    void learn(Integer guess, GuessFeedback feedback)
+    {
+        if (feedback == GuessFeedback::Greater) {
+            _min = guess + 1;
+        }
+        else if (feedback == GuessFeedback::Smaller) {
+            _max = guess - 1;
+        }
+    }
+
+private:
+    Integer _min;
+    Integer _max;
+};
+
+/// Plays the liar variant of guess the number: keeps the probability of each number given the answers so far (with Bayes' rule),
+/// and asks the question whose answer tells the most about the number (the one with the highest mutual information)
+/// The probabilities are stored as intervals of numbers that are all as likely as each other, because each answer only splits one interval in two
+/// and multiplies the probabilities on each side of the guess: an update costs a time proportional to the number of intervals, not to the size of the range.
+template<typename Integer>
+class LiarSolver {
+public:
+    LiarSolver(Integer min, Integer max, LieModel model)
+        : _model{model}
+        , _intervals{{min, max, 0, 1. / size_of(min, max)}}
+    {
+    }
+
+    Integer guess() const
+    {
+        // The information of an answer is its entropy, minus the part of it that only comes from the lies. The oracle can lie about all the numbers
+        // except the guess and the ones for which it already told all the lies it is allowed to (which it answers truthfully), so those are counted apart.
+        // All the numbers of an interval have the same probability, so the best guess of an interval is the one that splits the others
+        // into two halves as well as the interval allows, and the best guess is the best one of all the intervals.
+        const auto lies_entropy   = entropy_term(_model.probability) + entropy_term(1. - _model.probability);
+        double     may_lie_total  = 0.; // The probability that the number is one the oracle can still lie about
+        double     truthful_total = 0.; // The probability that the number is one the oracle can't lie about anymore
+        for (const auto& interval : _intervals) {
+            (lies_are_used_up(interval) ? truthful_total : may_lie_total) += interval.probability * size_of(interval.first, interval.last);
+        }
+        const auto information_of = [&](double may_lie_below, double truthful_below, double probability_of_guess, bool guess_may_lie) {
+            const auto may_lie_above  = std::max(0., may_lie_total - may_lie_below - (guess_may_lie ? probability_of_guess : 0.));
+            const auto truthful_above = std::max(0., truthful_total - truthful_below - (guess_may_lie ? 0. : probability_of_guess));
+            const auto greater        = (1. - _model.probability) * may_lie_above + _model.probability * may_lie_below + truthful_above;
+            const auto smaller        = (1. - _model.probability) * may_lie_below + _model.probability * may_lie_above + truthful_below;
+            return entropy_term(probability_of_guess) + entropy_term(greater) + entropy_term(smaller) - (may_lie_below + may_lie_above) * lies_entropy;
+        };
+        auto   best_guess       = _intervals.front().first;
+        double best_information = -1.;
+        double may_lie_below    = 0.;
+        double truthful_below   = 0.;
+        for (const auto& interval : _intervals) {
+            const bool may_lie      = !lies_are_used_up(interval);
+            const auto ideal_offset = std::round((0.5 - may_lie_below - truthful_below) / interval.probability - 0.5);
+            const auto max_offset   = static_cast<Unsigned>(static_cast<Unsigned>(interval.last) - static_cast<Unsigned>(interval.first));
+            const auto offset       = ideal_offset <= 0. ? Unsigned{0}
+                                      : ideal_offset >= static_cast<double>(max_offset) ? max_offset
+                                                                                         : static_cast<Unsigned>(ideal_offset);
+            const auto below_guess  = static_cast<double>(offset) * interval.probability;
+            const auto information  = information_of(may_lie_below + (may_lie ? below_guess : 0.), truthful_below + (may_lie ? 0. : below_guess),
+                                                     interval.probability, may_lie);
+            if (information > best_information) {
+                best_information = information;
+                best_guess       = static_cast<Integer>(static_cast<Unsigned>(interval.first) + offset);
+            }
+            (may_lie ? may_lie_below : truthful_below) += interval.probability * size_of(interval.first, interval.last);
+        }
+        return best_guess;
+    }
+
+    void learn(Integer guess, GuessFeedback feedback)
+    {
+        if (feedback == GuessFeedback::Correct) {
+            return;
+        }
+        // The guess is not the number, since the oracle never lies about it. The numbers on the side of the answer keep their probability
+        // if the answer was true, and the other ones keep theirs if it was a lie. When the oracle can't lie anymore about a number,
+        // a true answer was certain (and a lie impossible, which add() takes care of by dropping the numbers that would need too many lies).
+        const bool number_is_greater = feedback == GuessFeedback::Greater;
+        const auto lie_below         = number_is_greater ? 1 : 0;
+        const auto factor_below      = [&](const Interval& interval) {
+            return number_is_greater ? _model.probability : lies_are_used_up(interval) ? 1. : 1. - _model.probability;
+        };
+        const auto factor_above = [&](const Interval& interval) {
+            return !number_is_greater ? _model.probability : lies_are_used_up(interval) ? 1. : 1. - _model.probability;
+        };
+
+        _updated_intervals.clear();
+        double     total_probability = 0.;
+        const auto add               = [&](Integer first, Integer last, int lies_count, double probability) {
+            if (probability == 0. || (_model.max_lies.has_value() && lies_count > *_model.max_lies)) {
+                return;
+            }
+            total_probability += probability * size_of(first, last);
+            auto& intervals = _updated_intervals;
+            if (!intervals.empty() && intervals.back().last + 1 == first
+                && intervals.back().lies_count == lies_count && intervals.back().probability == probability) {
+                intervals.back().last = last;
+            }
+            else {
+                intervals.push_back({first, last, lies_count, probability});
+            }
+        };
+        for (const auto& interval : _intervals) {
+            if (interval.first < guess) {
+                add(interval.first, std::min(interval.last, static_cast<Integer>(guess - 1)), interval.lies_count + lie_below, interval.probability * factor_below(interval));
+            }
+            if (interval.last > guess) {
+                add(std::max(interval.first, static_cast<Integer>(guess + 1)), interval.last, interval.lies_count + 1 - lie_below, interval.probability * factor_above(interval));
+            }
+        }
+        for (auto& interval : _updated_intervals) {
+            interval.probability /= total_probability;
+        }
+        std::swap(_intervals, _updated_intervals);
+    }
+
+    size_t intervals_count() const { return _intervals.size(); }
+
+private:
+    struct Interval {
+        Integer first;
+        Integer last;
+        int     lies_count;  // How many of the answers were lies if the number is in this interval
+        double  probability; // The probability of each of the numbers of the interval
+    };
+
+    using Unsigned = typename UnsignedOf<Integer>::type;
+
+    /// The number of numbers between `first` and `last` (included), which doesn't overflow even when they are all the values of Integer
+    static double size_of(Integer first, Integer last) { return static_cast<double>(static_cast<Unsigned>(last) - static_cast<Unsigned>(first)) + 1.; }
+
+    static double entropy_term(double probability) { return probability > 0. ? -probability * std::log2(probability) : 0.; }
+
+    /// Returns true if the oracle has already told all the lies it is allowed to, if the number is in `interval`
+    bool lies_are_used_up(const Interval& interval) const { return _model.max_lies.has_value() && interval.lies_count >= *_model.max_lies; }
+
+private:
+    LieModel              _model;
+    std::vector<Interval> _intervals;
+    std::vector<Interval> _updated_intervals; // Kept to reuse its memory
+};
+
+/// A game of guess the number, that waits for the guesses in `inputs` and shows its answers on `screen`, which must live until the game is destroyed
+GameTask guess_the_number_game(SessionInputs& inputs, Screen& screen);
+
+void play_guess_the_number();
+
+/// Guess the number, but the computer may lie about whether the number is greater or smaller than the guess
+void play_liar_guess_the_number();
+
+/// Plays several games of guess the number at the same time, on a single thread that never blocks while it waits for the guesses
+void play_guess_the_number_sessions();
+
+/// Lets a BisectionBot play many rounds of guess the number, and shows how many rounds per second are played and how many guesses they take
+/// `arguments` are the number of rounds, and the range of the numbers: "100" (the one of the game), "64" (all the 64 bit numbers) or "128" (all the 128 bit numbers)
+int simulate_guess_the_number(const std::vector<std::string_view>& arguments);
+
+/// Lets a LiarSolver play many rounds of the liar variant of guess the number, and shows how many rounds per second are played and how many guesses they take
+/// `arguments` are the number of rounds and the range of the numbers like for simulate_guess_the_number().
+/// The oracle lies with the probability given with `--lie-probability` (0.1 by default), and at most `--max-lies` times per round if given.
+int simulate_liar_guess_the_number(const std::vector<std::string_view>& arguments);
\ No newline at end of file
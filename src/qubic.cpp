@@ -0,0 +1,130 @@
+#include "qubic.h"
+#include <p6/p6.h>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include "board.h"
+#include "noughts_and_crosses.h"
+#include "qubic_ai.h"
+#include "qubic_board.h"
+#include "session.h"
+#include "ultimate_noughts_and_crosses.h"
+
+/// The four layers of the cube are drawn side by side, as one board of 16 by 4 cells
+static const auto qubic_board_size = BoardSize{16, 4};
+
+CellIndex cell_index_of_qubic_cell(int cell)
+{
+    const int x = cell % 4;
+    const int y = (cell / 4) % 4;
+    const int z = cell / 16;
+    return {x + 4 * z, y};
+}
+
+int qubic_cell_at(CellIndex index)
+{
+    const int x = index.x % 4;
+    const int z = index.x / 4;
+    return x + 4 * index.y + 16 * z;
+}
+
+void draw_qubic_player(QubicPlayer player, CellIndex index, p6::Context& ctx)
+{
+    if (player == QubicPlayer::Noughts) {
+        draw_nought(index, qubic_board_size, ctx);
+    }
+    else {
+        draw_cross(index, qubic_board_size, ctx);
+    }
+}
+
+void draw_qubic(const QubicBoard& board, p6::Context& ctx)
+{
+    ctx.background({.3f, 0.25f, 0.35f});
+    ctx.fill          = {0.f, 0.f, 0.f, 0.f};
+    ctx.stroke        = {1.f, 1.f, 1.f, 0.5f};
+    ctx.stroke_weight = 0.01f;
+    draw_board(qubic_board_size, ctx);
+    ctx.stroke        = {1.f, 1.f, 1.f, 1.f};
+    ctx.stroke_weight = 0.04f;
+    draw_board({4, 1}, ctx); // The borders of the layers
+    for (int cell = 0; cell < 64; ++cell) {
+        for (const auto player : {QubicPlayer::Crosses, QubicPlayer::Noughts}) {
+            if (board.cells[index_of(player)] & (uint64_t{1} << cell)) {
+                draw_qubic_player(player, cell_index_of_qubic_cell(cell), ctx);
+            }
+        }
+    }
+}
+
+void try_draw_qubic_player_on_hovered_cell(const QubicBoard& board, p6::Context& ctx)
+{
+    const auto hovered_cell = cell_hovered_by(ctx.mouse(), qubic_board_size);
+    if (hovered_cell.has_value() && is_empty(board, qubic_cell_at(*hovered_cell))) {
+        draw_qubic_player(board.current_player, *hovered_cell, ctx);
+    }
+}
+
+bool qubic_game_is_finished(const QubicBoard& board)
+{
+    if (const auto winner_player = winner(board); winner_player.has_value()) {
+        if (*winner_player == QubicPlayer::Noughts) {
+            std::cout << "Noughts have won!\n";
+        }
+        else {
+            std::cout << "Crosses have won!\n";
+        }
+        return true;
+    }
+    else if (is_full(board)) {
+        std::cout << "This is a draw!\n";
+        return true;
+    }
+    else {
+        return false;
+    }
+}
+
+void play_qubic()
+{
+    const auto thinking_budget = ask_for_thinking_budget();
+    auto       board           = QubicBoard{};
+    auto       computer_move   = std::future<QubicSearchResult>{};
+    auto       ctx             = p6::Context{{1600, 400, "Qubic"}};
+
+    const auto is_computer_turn = [&]() {
+        return board.current_player == QubicPlayer::Noughts;
+    };
+    ctx.mouse_pressed = [&](p6::MouseButton event) {
+        const auto cell = cell_hovered_by(event.position, qubic_board_size);
+        if (!is_computer_turn() && cell.has_value() && is_empty(board, qubic_cell_at(*cell))) {
+            log_move(qubic_cell_at(*cell));
+            play(board, qubic_cell_at(*cell));
+        }
+    };
+    ctx.update = [&]() {
+        draw_qubic(board, ctx);
+        if (qubic_game_is_finished(board)) {
+            ctx.stop();
+            return;
+        }
+        if (!is_computer_turn()) {
+            if (const auto move = replayed_move(); move.has_value() && 0 <= *move && *move < 64 && is_empty(board, *move)) {
+                log_move(*move);
+                play(board, *move);
+                return;
+            }
+            try_draw_qubic_player_on_hovered_cell(board, ctx);
+        }
+        else if (!computer_move.valid()) { // The computer thinks on another thread so that the window stays responsive
+            computer_move = std::async(std::launch::async, &qubic_best_move, board, thinking_budget, replayed_ai_work());
+        }
+        else if (computer_move.wait_for(std::chrono::seconds{0}) == std::future_status::ready) {
+            const auto result = computer_move.get();
+            log_ai_work(result.depth);
+            std::cout << "The computer looked " << result.depth << " moves ahead before playing\n";
+            play(board, result.move);
+        }
+    };
+    ctx.start();
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+void play_qubic();
\ No newline at end of file
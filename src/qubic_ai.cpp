@@ -0,0 +1,231 @@
+#include "qubic_ai.h"
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+static constexpr int win_score = 1'000'000;
+
+int count_bits(uint64_t mask)
+{
+    int count = 0;
+    for (; mask != 0; mask &= mask - 1) {
+        count++;
+    }
+    return count;
+}
+
+/// The cells that belong to the most lines (the 8 corners and the 8 central cells, which belong to 7 lines) are tried first
+/// because they are usually the best moves, which makes alpha-beta prune a lot more
+static constexpr std::array<int8_t, 64> cells_by_importance = [] {
+    auto cells = std::array<int8_t, 64>{};
+    int  count = 0;
+    for (int lines_count = 7; lines_count >= 0; --lines_count) {
+        for (size_t cell = 0; cell < 64; ++cell) {
+            int cell_lines_count = 0;
+            while (cell_lines_count < 8 && qubic_lines_through_cell[cell][static_cast<size_t>(cell_lines_count)] != -1) {
+                cell_lines_count++;
+            }
+            if (cell_lines_count == lines_count) {
+                cells[static_cast<size_t>(count++)] = static_cast<int8_t>(cell);
+            }
+        }
+    }
+    return cells;
+}();
+
+/// Zobrist hashing: each (player, cell) pair gets a random key, and a position is the xor of the keys of its marks
+/// so that playing a move updates the hash with a single xor
+static constexpr std::array<std::array<uint64_t, 64>, 2> zobrist_keys = [] {
+    auto     keys  = std::array<std::array<uint64_t, 64>, 2>{};
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    for (auto& player_keys : keys) {
+        for (auto& key : player_keys) {
+            state += 0x9E3779B97F4A7C15ULL; // splitmix64
+            uint64_t z = state;
+            z          = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z          = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            key        = z ^ (z >> 31);
+        }
+    }
+    return keys;
+}();
+
+uint64_t zobrist_hash(const QubicBoard& board)
+{
+    uint64_t hash = 0;
+    for (size_t player = 0; player < 2; ++player) {
+        for (size_t cell = 0; cell < 64; ++cell) {
+            if (board.cells[player] & (uint64_t{1} << cell)) {
+                hash ^= zobrist_keys[player][cell];
+            }
+        }
+    }
+    return hash;
+}
+
+/// Scores the position from the point of view of the player whose turn it is:
+/// each line that only contains marks of one player is worth more the more marks it contains
+int evaluate(const QubicBoard& board)
+{
+    static constexpr std::array<int, 4> line_scores = {0, 1, 8, 64};
+
+    const auto mine   = board.cells[index_of(board.current_player)];
+    const auto theirs = board.cells[index_of(other_player(board.current_player))];
+    int        score  = 0;
+    for (const auto line : qubic_lines) {
+        if (!(theirs & line)) {
+            score += line_scores[static_cast<size_t>(count_bits(mine & line))];
+        }
+        else if (!(mine & line)) {
+            score -= line_scores[static_cast<size_t>(count_bits(theirs & line))];
+        }
+    }
+    return score;
+}
+
+enum class Bound : uint8_t {
+    Exact,
+    Lower, // The real score is at least the stored one (the search was cut by beta)
+    Upper, // The real score is at most the stored one (no move reached alpha)
+};
+
+struct TranspositionEntry {
+    uint64_t hash{};
+    int32_t  score{};
+    int8_t   depth{-1};
+    int8_t   best_move{-1};
+    Bound    bound{Bound::Exact};
+};
+
+class QubicSearch {
+public:
+    explicit QubicSearch(std::chrono::steady_clock::time_point deadline)
+        : _deadline{deadline}
+        , _transposition_table(table_size)
+    {
+    }
+
+    bool has_run_out_of_time() const { return _has_run_out_of_time; }
+
+    int best_move_at_root(const QubicBoard& board, int depth)
+    {
+        negamax(board, zobrist_hash(board), depth, -win_score - 1, win_score + 1, 0);
+        return entry(zobrist_hash(board)).best_move;
+    }
+
+    int root_score(const QubicBoard& board) { return entry(zobrist_hash(board)).score; }
+
+private:
+    TranspositionEntry& entry(uint64_t hash) { return _transposition_table[hash & (table_size - 1)]; }
+
+    /// Returns the score of `board` from the point of view of the player whose turn it is
+    int negamax(const QubicBoard& board, uint64_t hash, int depth, int alpha, int beta, int ply)
+    {
+        if (++_nodes_count % 4096 == 0 && std::chrono::steady_clock::now() > _deadline) {
+            _has_run_out_of_time = true;
+        }
+        if (_has_run_out_of_time) {
+            return 0;
+        }
+        if (is_full(board)) {
+            return 0;
+        }
+        if (depth == 0) {
+            return evaluate(board);
+        }
+
+        auto& stored = entry(hash);
+        if (stored.hash == hash && stored.depth >= depth) {
+            const auto score = score_from_table(stored.score, ply);
+            if (stored.bound == Bound::Exact ||
+                (stored.bound == Bound::Lower && score >= beta) ||
+                (stored.bound == Bound::Upper && score <= alpha)) {
+                return score;
+            }
+        }
+
+        const int original_alpha = alpha;
+        int       best_score     = -win_score - 1;
+        int       best_move      = -1;
+        const int hinted_move    = stored.hash == hash ? stored.best_move : -1;
+        for (int i = -1; i < 64; ++i) {
+            const int cell = i == -1 ? hinted_move : cells_by_importance[static_cast<size_t>(i)];
+            if (cell == -1 || (i != -1 && cell == hinted_move) || !is_empty(board, cell)) {
+                continue;
+            }
+            const auto player = index_of(board.current_player);
+            int        score  = 0;
+            if (completes_a_line(board.cells[player] | (uint64_t{1} << cell), cell)) {
+                score = win_score - ply; // Winning sooner is better
+            }
+            else {
+                auto next = board;
+                play(next, cell);
+                score = -negamax(next, hash ^ zobrist_keys[player][static_cast<size_t>(cell)], depth - 1, -beta, -alpha, ply + 1);
+            }
+            if (score > best_score) {
+                best_score = score;
+                best_move  = cell;
+            }
+            alpha = std::max(alpha, score);
+            if (alpha >= beta) {
+                break;
+            }
+        }
+        if (_has_run_out_of_time) {
+            return 0;
+        }
+
+        stored.hash      = hash;
+        stored.depth     = static_cast<int8_t>(depth);
+        stored.best_move = static_cast<int8_t>(best_move);
+        stored.score     = score_to_table(best_score, ply);
+        stored.bound     = best_score <= original_alpha ? Bound::Upper
+                           : best_score >= beta         ? Bound::Lower
+                                                        : Bound::Exact;
+        return best_score;
+    }
+
+    // The win scores depend on the distance to the root, but the table must store them relative to the position itself
+    static int score_to_table(int score, int ply)
+    {
+        return score > win_score - 64 ? score + ply : score < -win_score + 64 ? score - ply
+                                                                              : score;
+    }
+    static int score_from_table(int score, int ply)
+    {
+        return score > win_score - 64 ? score - ply : score < -win_score + 64 ? score + ply
+                                                                              : score;
+    }
+
+private:
+    static constexpr size_t table_size = size_t{1} << 20; // Must be a power of 2
+
+    std::chrono::steady_clock::time_point _deadline;
+    std::vector<TranspositionEntry>       _transposition_table;
+    int64_t                               _nodes_count{};
+    bool                                  _has_run_out_of_time{false};
+};
+
+QubicSearchResult qubic_best_move(const QubicBoard& board, std::chrono::milliseconds thinking_budget, std::optional<int> max_depth)
+{
+    // The searches up to a given depth always end the same way, because each one only depends on the ones before it (through the transposition table)
+    auto search = QubicSearch{max_depth.has_value() ? std::chrono::steady_clock::time_point::max() : std::chrono::steady_clock::now() + thinking_budget};
+    auto result = QubicSearchResult{-1, 0};
+    for (int depth = 1; depth <= max_depth.value_or(64); ++depth) {
+        const int move = search.best_move_at_root(board, depth);
+        if (search.has_run_out_of_time()) {
+            break;
+        }
+        result = {move, depth};
+        if (std::abs(search.root_score(board)) > win_score - 64) { // The outcome of the game is already known
+            break;
+        }
+    }
+    if (result.move == -1) { // Not even the first depth could be searched in time
+        result.move = *std::find_if(cells_by_importance.begin(), cells_by_importance.end(), [&](int8_t cell) {
+            return is_empty(board, cell);
+        });
+    }
+    return result;
+}
@@ -0,0 +1,15 @@
+#pragma once
+#include <chrono>
+#include <optional>
+#include "qubic_board.h"
+
+struct QubicSearchResult {
+    int move;
+    int depth; // How many moves ahead the search managed to look
+};
+
+/// Uses an alpha-beta search with iterative deepening and a transposition table to find a good move for `board.current_player`
+/// It goes deeper and deeper until `thinking_budget` is spent, and returns the best move of the deepest search that completed
+/// If `max_depth` is given, it searches up to this depth instead, whatever the time it takes, so that its move can be replayed.
+/// `board` must not be a finished game
+QubicSearchResult qubic_best_move(const QubicBoard& board, std::chrono::milliseconds thinking_budget, std::optional<int> max_depth);
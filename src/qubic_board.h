@@ -0,0 +1,122 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <optional>
+
+/// Qubic is noughts and crosses on a 4x4x4 cube: you need to align 4 of your marks to win.
+/// The cell (x, y, z) has index `x + 4 * y + 16 * z`, so that each player's marks fit in a 64-bit mask.
+
+enum class QubicPlayer : uint8_t {
+    Crosses,
+    Noughts,
+};
+
+inline QubicPlayer other_player(QubicPlayer player)
+{
+    return player == QubicPlayer::Crosses ? QubicPlayer::Noughts
+                                          : QubicPlayer::Crosses;
+}
+
+inline size_t index_of(QubicPlayer player)
+{
+    return static_cast<size_t>(player);
+}
+
+struct QubicBoard {
+    std::array<uint64_t, 2> cells{}; // Indexed by [player]
+    QubicPlayer             current_player{QubicPlayer::Crosses};
+};
+
+inline constexpr int qubic_lines_count = 76;
+
+/// All the winning lines of the cube: 48 that are parallel to an axis, 24 diagonals of the planes parallel to a face, and the 4 diagonals of the cube
+/// They are found by walking from each cell in each of the 13 directions that are not opposite to each other, and keeping the walks that stay inside the cube
+inline constexpr std::array<uint64_t, qubic_lines_count> qubic_lines = [] {
+    auto lines = std::array<uint64_t, qubic_lines_count>{};
+    int  count = 0;
+    for (int dz = -1; dz <= 1; ++dz) {
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                const bool is_canonical_direction = dz > 0 || (dz == 0 && (dy > 0 || (dy == 0 && dx > 0))); // Skips (0, 0, 0) and the opposite of each direction
+                if (!is_canonical_direction) {
+                    continue;
+                }
+                for (int z = 0; z < 4; ++z) {
+                    for (int y = 0; y < 4; ++y) {
+                        for (int x = 0; x < 4; ++x) {
+                            const auto is_inside = [](int coordinate) { return 0 <= coordinate && coordinate < 4; };
+                            if (!is_inside(x + 3 * dx) || !is_inside(y + 3 * dy) || !is_inside(z + 3 * dz)) {
+                                continue;
+                            }
+                            uint64_t line = 0;
+                            for (int step = 0; step < 4; ++step) {
+                                line |= uint64_t{1} << ((x + step * dx) + 4 * (y + step * dy) + 16 * (z + step * dz));
+                            }
+                            lines[static_cast<size_t>(count++)] = line;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return lines;
+}();
+
+/// The indices (in `qubic_lines`) of the lines that go through each cell. There are at most 7 of them, and -1 marks the end of the list.
+inline constexpr std::array<std::array<int8_t, 8>, 64> qubic_lines_through_cell = [] {
+    auto table = std::array<std::array<int8_t, 8>, 64>{};
+    for (size_t cell = 0; cell < 64; ++cell) {
+        size_t count = 0;
+        for (size_t line = 0; line < qubic_lines.size(); ++line) {
+            if (qubic_lines[line] & (uint64_t{1} << cell)) {
+                table[cell][count++] = static_cast<int8_t>(line);
+            }
+        }
+        table[cell][count] = -1;
+    }
+    return table;
+}();
+
+inline bool is_empty(const QubicBoard& board, int cell)
+{
+    return !((board.cells[0] | board.cells[1]) & (uint64_t{1} << cell));
+}
+
+inline bool is_full(const QubicBoard& board)
+{
+    return (board.cells[0] | board.cells[1]) == ~uint64_t{0};
+}
+
+/// Assumes that `cell` is empty
+inline void play(QubicBoard& board, int cell)
+{
+    board.cells[index_of(board.current_player)] |= uint64_t{1} << cell;
+    board.current_player = other_player(board.current_player);
+}
+
+/// Tells whether the mark in `cell` completes a line (only the 7 lines that go through `cell` need to be checked)
+inline bool completes_a_line(uint64_t player_cells, int cell)
+{
+    for (const auto line : qubic_lines_through_cell[static_cast<size_t>(cell)]) {
+        if (line == -1) {
+            return false;
+        }
+        const auto line_mask = qubic_lines[static_cast<size_t>(line)];
+        if ((player_cells & line_mask) == line_mask) {
+            return true;
+        }
+    }
+    return false;
+}
+
+inline std::optional<QubicPlayer> winner(const QubicBoard& board)
+{
+    for (const auto line : qubic_lines) {
+        for (const auto player : {QubicPlayer::Crosses, QubicPlayer::Noughts}) {
+            if ((board.cells[index_of(player)] & line) == line) {
+                return player;
+            }
+        }
+    }
+    return std::nullopt;
+}
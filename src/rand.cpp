@@ -0,0 +1,286 @@
+#include "rand.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include "input_source.h"
+#include "session.h"
+
+RandomGenerator::RandomGenerator(uint64_t seed)
+{
+    for (auto& state : _state) { // splitmix64
+        seed += 0x9E3779B97F4A7C15;
+        auto z = seed;
+        z      = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+        z      = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+        state  = z ^ (z >> 31);
+    }
+}
+
+void RandomGenerator::jump()
+{
+    static constexpr std::array<uint64_t, 4> jump_polynomial = {0x180EC6D33CFD0ABA, 0xD5A61266F0C9392C, 0xA9582618E03FC9AA, 0x39ABDC4529B1661C};
+
+    auto jumped = std::array<uint64_t, 4>{};
+    for (const auto bits : jump_polynomial) {
+        for (int bit = 0; bit < 64; ++bit) {
+            if (bits & (uint64_t{1} << bit)) {
+                for (size_t i = 0; i < jumped.size(); ++i) {
+                    jumped[i] ^= _state[i];
+                }
+            }
+            (*this)();
+        }
+    }
+    _state = jumped;
+}
+
+RandomGenerator next_random_stream()
+{
+    static auto mutex     = std::mutex{};
+    static auto generator = RandomGenerator{session_seed()};
+
+    const auto lock   = std::lock_guard{mutex};
+    const auto stream = generator;
+    generator.jump();
+    return stream;
+}
+
+BatchRandomGenerator::BatchRandomGenerator()
+    : _fallback{next_random_stream()}
+{
+    for (size_t lane = 0; lane < lanes_count; ++lane) {
+        const auto lane_state = next_random_stream().state();
+        for (size_t word = 0; word < _state.size(); ++word) {
+            _state[word][lane] = lane_state[word];
+        }
+    }
+}
+
+void BatchRandomGenerator::generate(uint32_t* numbers, size_t count)
+{
+    // The same steps as RandomGenerator::operator()(), written for all the lanes at once so that they are vectorised.
+    // The state is copied so that the compiler knows that it doesn't overlap `numbers`, and can keep it in registers.
+    auto       [s0, s1, s2, s3] = _state;
+    const auto next_block       = [&](uint32_t* block) {
+        for (size_t lane = 0; lane < lanes_count; ++lane) {
+            const auto times_5 = (s1[lane] << 2) + s1[lane]; // SIMD instruction sets before AVX-512 can't multiply 64 bit numbers, but they can shift and add
+            const auto rotated = (times_5 << 7) | (times_5 >> 57);
+            const auto result  = (rotated << 3) + rotated;
+            const auto t       = s1[lane] << 17;
+            s2[lane] ^= s0[lane];
+            s3[lane] ^= s1[lane];
+            s1[lane] ^= s2[lane];
+            s0[lane] ^= s3[lane];
+            s2[lane] ^= t;
+            s3[lane] = (s3[lane] << 45) | (s3[lane] >> 19);
+
+            block[lane]               = static_cast<uint32_t>(result >> 32);
+            block[lanes_count + lane] = static_cast<uint32_t>(result);
+        }
+    };
+    static constexpr size_t block_size = 2 * lanes_count;
+
+    size_t i = 0;
+    for (; i + block_size <= count; i += block_size) {
+        next_block(numbers + i);
+    }
+    if (i < count) {
+        auto last_block = std::array<uint32_t, block_size>{};
+        next_block(last_block.data());
+        std::copy_n(last_block.begin(), count - i, numbers + i);
+    }
+    _state = {s0, s1, s2, s3};
+}
+
+void BatchRandomGenerator::fill(std::vector<uint32_t>& numbers)
+{
+    generate(numbers.data(), numbers.size());
+}
+
+void BatchRandomGenerator::fill_below(std::vector<uint32_t>& numbers, uint32_t bound)
+{
+    static constexpr size_t chunk_size = 64;
+
+    generate(numbers.data(), numbers.size());
+    const auto threshold = (0u - bound) % bound;
+    for (size_t chunk = 0; chunk < numbers.size(); chunk += chunk_size) {
+        // All the numbers are mapped without any branch, and each chunk is only checked once for the numbers that would be biased
+        const auto chunk_end            = std::min(chunk + chunk_size, numbers.size());
+        uint32_t   biased_numbers_count = 0;
+        for (size_t i = chunk; i < chunk_end; ++i) {
+            const auto product = static_cast<uint64_t>(numbers[i]) * bound;
+            biased_numbers_count += static_cast<uint32_t>(static_cast<uint32_t>(product) < threshold);
+            numbers[i] = static_cast<uint32_t>(product >> 32);
+        }
+        if (biased_numbers_count != 0) {
+            // The random numbers are gone, but this almost never happens with small bounds so the whole chunk can be drawn again, one number at a time
+            for (size_t i = chunk; i < chunk_end; ++i) {
+                numbers[i] = _fallback.below(bound);
+            }
+        }
+    }
+}
+
+void BatchRandomGenerator::fill_canonical(std::vector<float>& numbers)
+{
+    static constexpr size_t chunk_size = 64;
+
+    auto bits = std::array<uint32_t, chunk_size>{};
+    for (size_t chunk = 0; chunk < numbers.size(); chunk += chunk_size) {
+        const auto count = std::min(chunk_size, numbers.size() - chunk);
+        generate(bits.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            numbers[chunk + i] = static_cast<float>(bits[i] >> 8) * 0x1.0p-24f; // A float has 24 bits of precision
+        }
+    }
+}
+
+void CounterRandomGenerator::next_blocks()
+{
+    // The n-th word of each counter is in `cn`, so that the words of all the counters are processed at once
+    auto c0 = std::array<uint32_t, blocks_count>{};
+    auto c1 = std::array<uint32_t, blocks_count>{};
+    auto c2 = std::array<uint32_t, blocks_count>{};
+    auto c3 = std::array<uint32_t, blocks_count>{};
+    for (size_t block = 0; block < blocks_count; ++block) {
+        c0[block] = static_cast<uint32_t>(_block_index + block);
+        c1[block] = static_cast<uint32_t>((_block_index + block) >> 32);
+        c2[block] = static_cast<uint32_t>(_stream);
+        c3[block] = static_cast<uint32_t>(_stream >> 32);
+    }
+    auto key = _key;
+    for (int round = 0; round < 10; ++round) {
+        for (size_t block = 0; block < blocks_count; ++block) {
+            const auto product_0 = uint64_t{0xD2511F53} * c0[block];
+            const auto product_1 = uint64_t{0xCD9E8D57} * c2[block];
+            c0[block]            = static_cast<uint32_t>(product_1 >> 32) ^ c1[block] ^ key[0];
+            c1[block]            = static_cast<uint32_t>(product_1);
+            c2[block]            = static_cast<uint32_t>(product_0 >> 32) ^ c3[block] ^ key[1];
+            c3[block]            = static_cast<uint32_t>(product_0);
+        }
+        key[0] += 0x9E3779B9;
+        key[1] += 0xBB67AE85;
+    }
+    // The numbers are kept in the order of the words rather than in the one of the counters, which is as random and doesn't need any shuffle
+    for (size_t block = 0; block < blocks_count; ++block) {
+        _numbers[block]                    = c0[block];
+        _numbers[blocks_count + block]     = c1[block];
+        _numbers[2 * blocks_count + block] = c2[block];
+        _numbers[3 * blocks_count + block] = c3[block];
+    }
+    _next_number = 0;
+    _block_index += blocks_count;
+}
+
+/// The generator that rand() used before: one std::default_random_engine shared by all the threads, and a new distribution for each number
+template<typename T>
+T rand_with_standard_library(T min, T max)
+{
+    static std::default_random_engine generator{std::random_device{}()};
+    std::uniform_int_distribution<T>  distribution{min, max};
+    return distribution(generator);
+}
+
+int benchmark_rand(const std::vector<std::string_view>& arguments)
+{
+    static constexpr int numbers_per_thread = 20'000'000;
+
+    auto threads_count = std::max(1u, std::thread::hardware_concurrency());
+    if (!arguments.empty()) {
+        const auto count = parse_input<unsigned int>(arguments[0]);
+        if (count.value_or(0) == 0) {
+            std::cout << "Usage: benchmark-rand [number of threads, at least 1]\n";
+            return 1;
+        }
+        threads_count = *count;
+    }
+    // The numbers are summed so that the compiler can't skip drawing them. Each thread gets its own generator, for the measures that use one directly.
+    const auto measure = [&](const char* name, unsigned int threads_count, auto&& make_generator, auto&& draw) {
+        auto       sum     = std::atomic<uint64_t>{0};
+        auto       threads = std::vector<std::thread>{};
+        const auto begin   = std::chrono::steady_clock::now();
+        for (unsigned int thread = 0; thread < threads_count; ++thread) {
+            threads.emplace_back([&, thread]() {
+                auto     generator  = make_generator(thread);
+                uint64_t thread_sum = 0;
+                for (int i = 0; i < numbers_per_thread; ++i) {
+                    thread_sum += static_cast<uint64_t>(draw(generator, i % 1000 + 1));
+                }
+                sum += thread_sum;
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        const auto seconds = std::chrono::duration<double>{std::chrono::steady_clock::now() - begin}.count();
+        std::cout << name << " on " << threads_count << " thread(s): "
+                  << static_cast<double>(numbers_per_thread) * threads_count / seconds / 1e6 << " million numbers per second"
+                  << " (average " << static_cast<double>(sum) / numbers_per_thread / threads_count << ")\n";
+    };
+    const auto random_stream  = [](unsigned int) { return next_random_stream(); };
+    const auto counter_stream = [](unsigned int thread) { return CounterRandomGenerator{session_seed(), thread}; };
+    for (const auto threads : {1u, threads_count}) {
+        if (threads == 1) {
+            // The old generator is not thread safe, so it is only measured on one thread
+            measure("std::default_random_engine and std::uniform_int_distribution", 1, random_stream, [](RandomGenerator&, int max) { return rand_with_standard_library(0, max); });
+        }
+        measure("rand()", threads, random_stream, [](RandomGenerator&, int max) { return rand(0, max); });
+        measure("RandomGenerator::below()", threads, random_stream, [](RandomGenerator& generator, int max) { return generator.below(static_cast<uint32_t>(max + 1)); });
+        measure("CounterRandomGenerator::below()", threads, counter_stream, [](CounterRandomGenerator& generator, int max) { return generator.below(static_cast<uint32_t>(max + 1)); });
+        if (threads_count == 1) {
+            break;
+        }
+    }
+
+    // The batches are measured on one thread, with a bound that doesn't change, like the number of moves of a game.
+    // Only a sample of the numbers is summed, since summing all of them would take longer than drawing them
+    static constexpr uint32_t bound       = 81;
+    static constexpr size_t   sample_step = 16;
+
+    auto       generator     = next_random_stream();
+    auto       batch         = BatchRandomGenerator{};
+    auto       numbers       = std::vector<uint32_t>(4096);
+    auto       floats        = std::vector<float>(4096);
+    const auto measure_batch = [&](const char* name, auto&& fill) {
+        double     sum    = 0.;
+        const auto begin  = std::chrono::steady_clock::now();
+        for (size_t filled = 0; filled < numbers_per_thread; filled += numbers.size()) {
+            sum += fill();
+        }
+        const auto seconds = std::chrono::duration<double>{std::chrono::steady_clock::now() - begin}.count();
+        std::cout << name << ": " << numbers_per_thread / seconds / 1e6 << " million numbers per second"
+                  << " (average " << sum * sample_step / numbers_per_thread << ")\n";
+    };
+    const auto sum_of = [](const auto& numbers) {
+        double sum = 0.;
+        for (size_t i = 0; i < numbers.size(); i += sample_step) {
+            sum += static_cast<double>(numbers[i]);
+        }
+        return sum;
+    };
+    measure_batch("RandomGenerator::below(), one call per number", [&]() {
+        for (auto& number : numbers) {
+            number = generator.below(bound);
+        }
+        return sum_of(numbers);
+    });
+    measure_batch("BatchRandomGenerator::fill_below()", [&]() {
+        batch.fill_below(numbers, bound);
+        return sum_of(numbers);
+    });
+    measure_batch("RandomGenerator::canonical(), one call per number", [&]() {
+        for (auto& number : floats) {
+            number = static_cast<float>(generator.canonical());
+        }
+        return sum_of(floats);
+    });
+    measure_batch("BatchRandomGenerator::fill_canonical()", [&]() {
+        batch.fill_canonical(floats);
+        return sum_of(floats);
+    });
+    return 0;
+}
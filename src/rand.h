@@ -1,11 +1,268 @@
 #pragma once
-#include <random>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
-/// Returns a random integer between min (included) and max (included)
+#if defined(__SIZEOF_INT128__)
+__extension__ using int128  = __int128;
+__extension__ using uint128 = unsigned __int128;
+#endif
+
+/// std::make_unsigned_t, that also knows the 128 bit integers when the standard library doesn't (with -std=c++17 instead of -std=gnu++17)
+template<typename Integer>
+struct UnsignedOf {
+    using type = std::make_unsigned_t<Integer>;
+};
+#if defined(__SIZEOF_INT128__)
+template<>
+struct UnsignedOf<int128> {
+    using type = uint128;
+};
+template<>
+struct UnsignedOf<uint128> {
+    using type = uint128;
+};
+#endif
+
+/// Returns the high and the low halves of the 128 bit product of `a` and `b`
+inline std::pair<uint64_t, uint64_t> full_multiply(uint64_t a, uint64_t b)
+{
+#if defined(__SIZEOF_INT128__)
+    const auto product = static_cast<uint128>(a) * b;
+    return {static_cast<uint64_t>(product >> 64), static_cast<uint64_t>(product)};
+#else
+    const auto low_low   = (a & 0xFFFFFFFF) * (b & 0xFFFFFFFF);
+    const auto high_low  = (a >> 32) * (b & 0xFFFFFFFF);
+    const auto low_high  = (a & 0xFFFFFFFF) * (b >> 32);
+    const auto high_high = (a >> 32) * (b >> 32);
+    const auto middle    = (low_low >> 32) + (high_low & 0xFFFFFFFF) + low_high;
+    return {high_high + (high_low >> 32) + (middle >> 32), (middle << 32) | (low_low & 0xFFFFFFFF)};
+#endif
+}
+
+/// Returns a random number that can have any value of Unsigned, drawn from `generator`
+template<typename Unsigned, typename Generator>
+Unsigned random_bits(Generator& generator)
+{
+    if constexpr (sizeof(Unsigned) > sizeof(uint64_t)) {
+        const auto high = static_cast<Unsigned>(generator());
+        return (high << 64) | generator();
+    }
+    else {
+        return static_cast<Unsigned>(generator());
+    }
+}
+
+/// Returns a random number between 0 (included) and `bound` (excluded), drawn from `generator`, `bound` must not be 0
+/// Uses the method of Lemire: the number is the high half of a multiplication, and the low half tells when it would be biased,
+/// which almost never happens, so that there is almost never a division.
+template<typename Unsigned, typename Generator>
+Unsigned random_below(Generator& generator, Unsigned bound)
+{
+    static_assert(static_cast<Unsigned>(-1) > Unsigned{0}, "The bound must be unsigned");
+    if constexpr (sizeof(Unsigned) > sizeof(uint64_t)) {
+        // There is no 256 bit multiplication for the method of Lemire, so the numbers are drawn with as many bits as `bound - 1` has,
+        // until one of them is below `bound`, which takes less than two draws on average
+        auto mask = static_cast<Unsigned>(bound - 1);
+        for (int shift = 1; shift < static_cast<int>(8 * sizeof(Unsigned)); shift *= 2) {
+            mask |= mask >> shift;
+        }
+        auto number = random_bits<Unsigned>(generator) & mask;
+        while (number >= bound) {
+            number = random_bits<Unsigned>(generator) & mask;
+        }
+        return number;
+    }
+    else if constexpr (sizeof(Unsigned) <= sizeof(uint32_t)) {
+        auto product = static_cast<uint64_t>(generator.next_32_bits()) * bound;
+        if (static_cast<uint32_t>(product) < bound) {
+            const auto threshold = static_cast<uint32_t>(-static_cast<uint32_t>(bound)) % bound;
+            while (static_cast<uint32_t>(product) < threshold) {
+                product = static_cast<uint64_t>(generator.next_32_bits()) * bound;
+            }
+        }
+        return static_cast<Unsigned>(product >> 32);
+    }
+    else {
+        auto [high, low] = full_multiply(generator(), bound);
+        if (low < bound) {
+            const auto threshold = (0 - static_cast<uint64_t>(bound)) % bound;
+            while (low < threshold) {
+                std::tie(high, low) = full_multiply(generator(), bound);
+            }
+        }
+        return static_cast<Unsigned>(high);
+    }
+}
+
+/// xoshiro256** by Blackman and Vigna: a few instructions per number, 256 bits of state,
+/// and it can jump ahead by 2^128 numbers, which gives each thread its own stream that never overlaps the other ones
+/// Can be used with the standard library, e.g. std::shuffle().
+class RandomGenerator {
+public:
+    using result_type = uint64_t;
+
+    /// The 256 bits of state are derived from `seed` with splitmix64, as recommended by the authors
+    explicit RandomGenerator(uint64_t seed);
+
+    uint64_t operator()()
+    {
+        const auto result = rotate_left(_state[1] * 5, 7) * 9;
+        const auto t      = _state[1] << 17;
+        _state[2] ^= _state[0];
+        _state[3] ^= _state[1];
+        _state[1] ^= _state[2];
+        _state[0] ^= _state[3];
+        _state[2] ^= t;
+        _state[3] = rotate_left(_state[3], 45);
+        return result;
+    }
+
+    uint32_t next_32_bits() { return static_cast<uint32_t>((*this)() >> 32); } // The high bits are the best ones
+
+    /// Returns a random number between 0 (included) and `bound` (excluded), `bound` must not be 0 (see random_below())
+    template<typename Unsigned>
+    Unsigned below(Unsigned bound) { return random_below(*this, bound); }
+
+    /// Returns a random number between 0 (included) and 1 (excluded)
+    double canonical() { return static_cast<double>((*this)() >> 11) * 0x1.0p-53; }
+
+    /// Moves the generator 2^128 numbers ahead
+    void jump();
+
+    const std::array<uint64_t, 4>& state() const { return _state; }
+
+    static constexpr uint64_t min() { return 0; }
+    static constexpr uint64_t max() { return std::numeric_limits<uint64_t>::max(); }
+
+private:
+    static uint64_t rotate_left(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+private:
+    std::array<uint64_t, 4> _state;
+};
+
+/// Returns a generator that starts 2^128 numbers after the previous one that this function returned
+/// The first one is seeded with the seed of the session (see session.h), so that the games can be replayed.
+/// Can be called by several threads at the same time, but the threads only get the same streams when a session is replayed if they ask for them in the same order.
+RandomGenerator next_random_stream();
+
+/// The generator of the calling thread, which has its own stream (see next_random_stream())
+inline RandomGenerator& thread_random_generator()
+{
+    thread_local auto generator = next_random_stream();
+    return generator;
+}
+
+/// Several xoshiro256** generators that run side by side, to fill big buffers of random numbers at once
+/// Their states are interleaved, so that the compiler turns each step of all the lanes into a few SIMD instructions.
+/// Each lane has its own stream from next_random_stream().
+class BatchRandomGenerator {
+public:
+    static constexpr size_t lanes_count = 8;
+
+    BatchRandomGenerator();
+
+    /// Fills `numbers` with random 32 bit numbers
+    void fill(std::vector<uint32_t>& numbers);
+
+    /// Fills `numbers` with random numbers between 0 (included) and `bound` (excluded), `bound` must not be 0
+    /// Uses the method of Lemire like RandomGenerator::below(), but the division that detects the biased numbers is only done once for all of them,
+    /// and it is only fast when `bound` is small compared to 2^32, which makes the biased numbers very rare.
+    void fill_below(std::vector<uint32_t>& numbers, uint32_t bound);
+
+    /// Fills `numbers` with random numbers between 0 (included) and 1 (excluded)
+    void fill_canonical(std::vector<float>& numbers);
+
+private:
+    /// Writes `count` random 32 bit numbers to `numbers`: each step of the lanes makes a 64 bit number per lane, that is split into two 32 bit numbers
+    void generate(uint32_t* numbers, size_t count);
+
+private:
+    std::array<std::array<uint64_t, lanes_count>, 4> _state; // The n-th word of the state of each lane
+    RandomGenerator                                  _fallback; // Replaces the rare numbers that would be biased
+};
+
+/// Philox4x32-10 by Salmon et al.: a counter-based generator, whose n-th number only depends on its key and on n, like a cipher of n
+/// The key is the seed, and each counter is made of the index of a stream (e.g. the index of a game in a simulation) and of the index of a block of numbers
+/// in that stream. Two streams never encrypt the same counter, so they never overlap.
+/// When each game of a simulation draws from its own stream, its numbers don't depend on which thread plays it or when,
+/// so that a simulation gives the same results on any number of threads.
+class CounterRandomGenerator {
+public:
+    using result_type = uint64_t;
+
+    CounterRandomGenerator(uint64_t seed, uint64_t stream)
+        : _key{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)}
+        , _stream{stream}
+    {
+    }
+
+    uint64_t operator()()
+    {
+        const auto high = next_32_bits();
+        return (uint64_t{high} << 32) | next_32_bits();
+    }
+
+    uint32_t next_32_bits()
+    {
+        if (_next_number == _numbers.size()) {
+            next_blocks();
+        }
+        return _numbers[_next_number++];
+    }
+
+    /// Returns a random number between 0 (included) and `bound` (excluded), `bound` must not be 0 (see random_below())
+    template<typename Unsigned>
+    Unsigned below(Unsigned bound) { return random_below(*this, bound); }
+
+    /// Returns a random number between 0 (included) and 1 (excluded)
+    double canonical() { return static_cast<double>((*this)() >> 11) * 0x1.0p-53; }
+
+    static constexpr uint64_t min() { return 0; }
+    static constexpr uint64_t max() { return std::numeric_limits<uint64_t>::max(); }
+
+private:
+    static constexpr size_t blocks_count = 8;
+
+    /// Encrypts the next counters, made of the index of a block and of the stream, with 10 rounds of Philox, which gives four 32 bit numbers per counter
+    /// Several counters are encrypted side by side, so that the compiler turns each round into a few SIMD instructions.
+    void next_blocks();
+
+private:
+    std::array<uint32_t, 2>                _key;
+    uint64_t                               _stream;
+    uint64_t                               _block_index{0}; // The index of the first counter that has not been encrypted yet
+    std::array<uint32_t, 4 * blocks_count> _numbers{};
+    size_t                                 _next_number{_numbers.size()};
+};
+
+/// Returns a random integer between min (included) and max (included), which can have up to 128 bits,
+/// or a random floating point number between min (included) and max (excluded)
+/// Each thread uses its own generator, so it can be called by several threads at the same time.
 template<typename T>
 T rand(T min, T max)
 {
-    static std::default_random_engine generator{std::random_device{}()};
-    std::uniform_int_distribution<T>  distribution{min, max};
-    return distribution(generator);
-}
\ No newline at end of file
+    auto& generator = thread_random_generator();
+    if constexpr (std::is_floating_point_v<T>) {
+        return min + static_cast<T>(generator.canonical()) * (max - min);
+    }
+    else {
+        using Unsigned   = typename UnsignedOf<T>::type;
+        const auto range = static_cast<Unsigned>(static_cast<Unsigned>(max) - static_cast<Unsigned>(min));
+        if (range == static_cast<Unsigned>(-1)) { // All the values are possible, and range + 1 would overflow
+            return static_cast<T>(random_bits<Unsigned>(generator));
+        }
+        return static_cast<T>(static_cast<Unsigned>(min) + generator.below(static_cast<Unsigned>(range + 1)));
+    }
+}
+
+/// Compares the speed of rand() with the one of the standard distributions, on one thread and on several threads,
+/// the speed of a CounterRandomGenerator with the one of a RandomGenerator, and the speed of a BatchRandomGenerator with the one of a RandomGenerator
+/// `arguments` can contain the number of threads (one per core by default)
+int benchmark_rand(const std::vector<std::string_view>& arguments);
\ No newline at end of file
@@ -0,0 +1,126 @@
+#include "screen.h"
+#include <chrono>
+#include <iostream>
+#include "word_with_missing_letters.h"
+
+void Screen::present()
+{
+    if (!_text.empty()) {
+        std::fwrite(_text.data(), 1, _text.size(), _output);
+    }
+    std::fflush(_output);
+    _text.clear();
+}
+
+Screen& ScreenMultiplexer::screen(size_t session)
+{
+    if (session >= _screens.size()) {
+        _screens.resize(session + 1);
+    }
+    return _screens[session];
+}
+
+void ScreenMultiplexer::present()
+{
+    for (size_t session = 0; session < _screens.size(); ++session) {
+        auto text = _screens[session].text();
+        while (!text.empty()) {
+            const auto line_end = std::min(text.find('\n'), text.size() - 1) + 1;
+            _frame << session << "| " << text.substr(0, line_end);
+            text.remove_prefix(line_end);
+        }
+        _screens[session].clear();
+    }
+    _frame.present();
+}
+
+/// Writes the screen of a hangman turn piece by piece, like the games did before they had a Screen
+static void write_hangman_turn_piece_by_piece(const WordWithMissingLetters& word, int number_of_lives, std::FILE* output)
+{
+    const auto write = [&](std::string_view text) {
+        std::fwrite(text.data(), 1, text.size(), output);
+    };
+    write("You have ");
+    write(std::to_string(number_of_lives));
+    write(" lives\n");
+    for (size_t i = 0; i < word.word().size(); ++i) {
+        write(word.is_revealed(i) ? word.word().substr(i, 1) : "_");
+        write(" ");
+    }
+    write("\n");
+}
+
+static void write_hangman_turn(const WordWithMissingLetters& word, int number_of_lives, Screen& screen)
+{
+    screen << "You have " << number_of_lives << " lives\n";
+    for (size_t i = 0; i < word.word().size(); ++i) {
+        screen << (word.is_revealed(i) ? word.word()[i] : '_') << ' ';
+    }
+    screen << '\n';
+}
+
+/// Opens the null device, so that the benchmarks only measure the cost of the writes and not the one of a terminal
+static std::FILE* open_null_device()
+{
+#if defined(_WIN32)
+    return std::fopen("NUL", "wb");
+#else
+    return std::fopen("/dev/null", "wb");
+#endif
+}
+
+int benchmark_screen(const std::vector<std::string_view>&)
+{
+    static constexpr int sessions_count = 64;
+    static constexpr int frames_count   = 1000;
+
+    auto word = WordWithMissingLetters{"hippopotomonstrosesquippedaliophobia"};
+    word.mark_as_guessed('o');
+    word.mark_as_guessed('p');
+
+    // Each measure shows the screen of every session on every frame, so they all write the same text
+    const auto measure = [&](const char* name, int buffering_mode, auto&& show_frames) {
+        auto* output = open_null_device();
+        if (output == nullptr) {
+            std::cout << "Could not open the null device\n";
+            return false;
+        }
+        std::setvbuf(output, nullptr, buffering_mode, BUFSIZ);
+        const auto begin = std::chrono::steady_clock::now();
+        show_frames(output);
+        const auto end = std::chrono::steady_clock::now();
+        std::fclose(output);
+        std::cout << name << ": " << std::chrono::duration<double, std::micro>{end - begin}.count() / frames_count << " us per frame of " << sessions_count << " sessions\n";
+        return true;
+    };
+    const bool success = measure("One write per piece of text", _IONBF, [&](std::FILE* output) {
+        for (int frame = 0; frame < frames_count; ++frame) {
+            for (int session = 0; session < sessions_count; ++session) {
+                write_hangman_turn_piece_by_piece(word, session % 8 + 1, output);
+            }
+        }
+    }) && measure("One write per line", _IOLBF, [&](std::FILE* output) {
+        for (int frame = 0; frame < frames_count; ++frame) {
+            for (int session = 0; session < sessions_count; ++session) {
+                write_hangman_turn_piece_by_piece(word, session % 8 + 1, output);
+            }
+        }
+    }) && measure("One write per screen", _IONBF, [&](std::FILE* output) {
+        auto screen = Screen{output};
+        for (int frame = 0; frame < frames_count; ++frame) {
+            for (int session = 0; session < sessions_count; ++session) {
+                write_hangman_turn(word, session % 8 + 1, screen);
+                screen.present();
+            }
+        }
+    }) && measure("One write per frame", _IONBF, [&](std::FILE* output) {
+        auto multiplexer = ScreenMultiplexer{output};
+        for (int frame = 0; frame < frames_count; ++frame) {
+            for (int session = 0; session < sessions_count; ++session) {
+                write_hangman_turn(word, session % 8 + 1, multiplexer.screen(static_cast<size_t>(session)));
+            }
+            multiplexer.present();
+        }
+    });
+    return success ? 0 : 1;
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <array>
+#include <charconv>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/// The text that a game shows at once (e.g. the lives and the word of hangman), built in memory and then written with a single write
+/// The buffer is kept from one screen to the next, so that building a screen doesn't allocate once it has grown to the size of the biggest one.
+class Screen {
+public:
+    explicit Screen(std::FILE* output = stdout)
+        : _output{output}
+    {
+    }
+
+    Screen& operator<<(std::string_view text)
+    {
+        _text.append(text);
+        return *this;
+    }
+
+    Screen& operator<<(char character)
+    {
+        _text.push_back(character);
+        return *this;
+    }
+
+    template<typename Integer, std::enable_if_t<std::is_integral_v<Integer> && !std::is_same_v<Integer, char>, int> = 0>
+    Screen& operator<<(Integer number)
+    {
+        auto       digits = std::array<char, 24>{};
+        const auto result = std::to_chars(digits.data(), digits.data() + digits.size(), number);
+        _text.append(digits.data(), result.ptr);
+        return *this;
+    }
+
+    std::string_view text() const { return _text; }
+    void             clear() { _text.clear(); }
+
+    /// Writes the screen and clears it
+    /// The output is flushed, so that the text is visible before the game waits for the user.
+    void present();
+
+private:
+    std::FILE*  _output;
+    std::string _text;
+};
+
+/// Gathers the screens of several games that are played at the same time and share the same output, and writes them all with a single write
+/// Each line is prefixed with the number of its session, so that the outputs can be told apart (except the lines of shared_screen()).
+class ScreenMultiplexer {
+public:
+    explicit ScreenMultiplexer(std::FILE* output = stdout)
+        : _frame{output}
+    {
+    }
+
+    /// The screen of `session`, in which the session writes what it wants to show in the next frame
+    Screen& screen(size_t session);
+
+    /// Where to write the lines that are not about one session (e.g. instructions for all of them), which are shown without a prefix before the screens of the sessions
+    Screen& shared_screen() { return _frame; }
+
+    /// Writes the screens that are not empty, and clears them
+    void present();
+
+private:
+    std::vector<Screen> _screens;
+    Screen              _frame; // Reused from one frame to the next
+};
+
+/// Compares the time it takes to show hangman screens with one write per piece of text, with one write per line, with one write per screen
+/// and with one write for the screens of several sessions
+int benchmark_screen(const std::vector<std::string_view>& arguments);
@@ -0,0 +1,152 @@
+#include "session.h"
+#include <charconv>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string_view>
+#include "options.h"
+
+/// Returns std::nullopt if `text` is not a number
+static std::optional<uint64_t> parse_seed(std::string_view text)
+{
+    uint64_t   seed   = 0;
+    const auto result = std::from_chars(text.data(), text.data() + text.size(), seed);
+    if (result.ec != std::errc{} || result.ptr != text.data() + text.size()) {
+        return std::nullopt;
+    }
+    return seed;
+}
+
+/// The log given with `--replay <file>`, or std::nullopt if we are not replaying a session
+static std::optional<InputSource>& replayed_log()
+{
+    static auto log = []() -> std::optional<InputSource> {
+        const auto path = option("replay");
+        if (!path.has_value()) {
+            return std::nullopt;
+        }
+        auto file = InputSource::script(std::filesystem::path{*path});
+        if (!file.has_value()) {
+            std::cout << "Could not read \"" << *path << "\", starting a new session instead\n";
+        }
+        return file;
+    }();
+    return log;
+}
+
+/// The script that replaces the usual input of the session, see use_script_as_session_input()
+static InputSource* script = nullptr; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+std::optional<uint64_t> seed_of_log(InputSource& log)
+{
+    const auto header = log.next_line().value_or("");
+    if (header.substr(0, 5) != "seed ") {
+        return std::nullopt;
+    }
+    return parse_seed(header.substr(5));
+}
+
+uint64_t session_seed()
+{
+    static const auto seed = []() -> uint64_t {
+        if (auto& log = replayed_log(); log.has_value()) {
+            if (const auto seed = seed_of_log(*log); seed.has_value()) {
+                return *seed;
+            }
+            std::cout << "The log to replay doesn't start with its seed, using a new one\n";
+        }
+        if (const auto seed = option("seed"); seed.has_value()) {
+            if (const auto parsed_seed = parse_seed(*seed); parsed_seed.has_value()) {
+                return *parsed_seed;
+            }
+            std::cout << "The seed must be a number, ignoring \"" << *seed << "\"\n";
+        }
+        if (const char* seed = std::getenv("SIMPLE_CPP_SEED"); seed != nullptr) { // NOLINT(concurrency-mt-unsafe) Called once, before the threads that need random numbers
+            if (const auto parsed_seed = parse_seed(seed); parsed_seed.has_value()) {
+                return *parsed_seed;
+            }
+            std::cout << "The seed must be a number, ignoring SIMPLE_CPP_SEED=\"" << seed << "\"\n";
+        }
+        return (uint64_t{std::random_device{}()} << 32) | std::random_device{}();
+    }();
+    return seed;
+}
+
+InputSource& session_input()
+{
+    static auto console = InputSource::console();
+
+    if (script != nullptr) {
+        return *script;
+    }
+    session_seed(); // Skips the seed at the beginning of the log
+    if (auto& log = replayed_log(); log.has_value()) {
+        return *log;
+    }
+    return console;
+}
+
+void use_script_as_session_input(InputSource* new_script)
+{
+    script = new_script;
+}
+
+std::ostream& session_log()
+{
+    static auto no_log = std::ofstream{};
+    if (script != nullptr) {
+        return no_log;
+    }
+    static auto log = []() {
+        auto path = std::filesystem::temp_directory_path() / "last_session.log";
+        if (const auto log_option = option("log"); log_option.has_value()) {
+            path = *log_option;
+        }
+        else if (replayed_log().has_value()) {
+            return std::ofstream{};
+        }
+        auto file = std::ofstream{path};
+        file << "seed " << session_seed() << std::endl;
+        return file;
+    }();
+    return log;
+}
+
+/// Reads the next line of the input of the session if it starts with `prefix`, and returns the number that follows it
+/// Nothing is read if the line is not such a line, or if the input is the console (where these lines are never typed).
+static std::optional<int> next_number_after(std::string_view prefix)
+{
+    auto&      input = session_input();
+    const auto line  = input.peek_line();
+    if (!line.has_value() || line->substr(0, prefix.size()) != prefix) {
+        return std::nullopt;
+    }
+    const auto number = parse_input<int>(line->substr(prefix.size()));
+    if (number.has_value()) {
+        input.next_line();
+    }
+    return number;
+}
+
+std::optional<int> replayed_move()
+{
+    return next_number_after("move ");
+}
+
+void log_move(int move)
+{
+    session_log() << "move " << move << std::endl;
+}
+
+std::optional<int> replayed_ai_work()
+{
+    return next_number_after("ai ");
+}
+
+void log_ai_work(int amount)
+{
+    session_log() << "ai " << amount << std::endl;
+}
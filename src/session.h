@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+#include <iosfwd>
+#include <optional>
+#include "input_source.h"
+
+/// A session is one run of the program. It can be replayed exactly: all the random numbers come from a single seed,
+/// and the seed and everything the user inputs are written to a log, that can be given back with `--replay <file>`.
+///
+/// The seed is, in this order of priority:
+///   - the one of the log given with `--replay <file>`
+///   - the one given with `--seed <number>`
+///   - the one of the SIMPLE_CPP_SEED environment variable
+///   - a random one
+/// The log is written to the file given with `--log <file>`, or to "last_session.log" in the temporary directory
+/// (except when replaying, so that replaying a session doesn't overwrite it).
+/// The log starts with a line "seed <number>", followed by one input per line.
+/// The games that are played with the mouse and against an AI also write the moves of the user ("move <number>")
+/// and how much the AI thought before each of its moves ("ai <amount>"), see replayed_move() and replayed_ai_work().
+
+/// The seed of the session
+uint64_t session_seed();
+
+/// Where the inputs of the user come from: the console, the rest of the log when replaying a session, or a script (see use_script_as_session_input())
+InputSource& session_input();
+
+/// Makes the session read its inputs from `script` instead, until it is called with nullptr
+/// The inputs of a script are not written to the log of the session, since they are already in a file.
+void use_script_as_session_input(InputSource* script);
+
+/// Reads the first line of `log`, and returns the seed that it contains if it is a "seed <number>" line
+std::optional<uint64_t> seed_of_log(InputSource& log);
+
+/// Where the inputs of the user must be written, after the seed (nothing is written if the log could not be opened)
+std::ostream& session_log();
+
+/// Returns the next move of the session that is being replayed, or std::nullopt if the user must play it (with the mouse)
+std::optional<int> replayed_move();
+
+/// Writes a move that the user played with the mouse to the log of the session
+void log_move(int move);
+
+/// The AIs that think for a given time don't do the same amount of work from one run to the next (the playouts of MCTS, the depth of an alpha-beta search),
+/// so they write the amount of work they did to the log, and do exactly that amount again when the session is replayed.
+/// Returns the amount of work of the next move of the AI in the session that is being replayed, or std::nullopt if the AI must think for its time budget.
+std::optional<int> replayed_ai_work();
+
+/// Writes how much an AI worked on its move to the log of the session
+void log_ai_work(int amount);
@@ -0,0 +1,58 @@
+#include "tablebase.h"
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+/// The file starts with this header, and then contains the packed results
+struct TablebaseHeader {
+    std::array<char, 8> magic_number;
+    uint64_t            positions_count;
+};
+
+static constexpr std::array<char, 8> tablebase_magic_number = {'T', 'B', 'A', 'S', 'E', '0', '0', '1'};
+
+bool save_tablebase(const PackedGameResults& results, uint64_t positions_count, const std::filesystem::path& path)
+{
+    auto file = std::ofstream{path, std::ios::binary};
+    if (!file) {
+        return false;
+    }
+    const auto header = TablebaseHeader{tablebase_magic_number, positions_count};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    file.write(reinterpret_cast<const char*>(results.bytes().data()),  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+               static_cast<std::streamsize>(results.bytes().size()));
+    return static_cast<bool>(file);
+}
+
+std::optional<Tablebase> Tablebase::open(const std::filesystem::path& path, uint64_t positions_count)
+{
+    auto file = MemoryMappedFile::open(path);
+    if (!file.has_value() || file->size() != sizeof(TablebaseHeader) + (positions_count + 3) / 4) {
+        return std::nullopt;
+    }
+    auto header = TablebaseHeader{};
+    std::memcpy(&header, file->data(), sizeof(header));
+    if (header.magic_number != tablebase_magic_number || header.positions_count != positions_count) {
+        return std::nullopt;
+    }
+    return std::make_optional(Tablebase{std::move(*file)});
+}
+
+GameResult Tablebase::result(uint64_t position_index) const
+{
+    const auto* results = reinterpret_cast<const uint8_t*>(_file.data() + sizeof(TablebaseHeader)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    return PackedGameResults::unpack(results, position_index);
+}
+
+void show_tablebase_statistics(const PackedGameResults& results, uint64_t positions_count)
+{
+    auto counts = std::array<uint64_t, 4>{};
+    for (uint64_t index = 0; index < positions_count; ++index) {
+        counts[static_cast<size_t>(results.get(index))]++;
+    }
+    std::cout << counts[static_cast<size_t>(GameResult::Win)] << " positions are won, "
+              << counts[static_cast<size_t>(GameResult::Loss)] << " are lost and "
+              << counts[static_cast<size_t>(GameResult::Draw)] << " are drawn for the player whose turn it is ("
+              << counts[static_cast<size_t>(GameResult::Unknown)] << " indices are not valid positions)\n";
+}
@@ -0,0 +1,133 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <utility>
+#include <vector>
+#include "memory_mapped_file.h"
+
+/// The result of a position for the player whose turn it is, assuming that both players play perfectly
+enum class GameResult : uint8_t {
+    Unknown, // Used for the indices that don't correspond to a position that can happen in a game
+    Win,
+    Loss,
+    Draw,
+};
+
+/// Stores a GameResult on 2 bits, so that 4 of them fit in a byte
+class PackedGameResults {
+public:
+    explicit PackedGameResults(uint64_t size)
+        : _bytes((size + 3) / 4, uint8_t{0})
+    {
+    }
+
+    GameResult get(uint64_t index) const { return unpack(_bytes.data(), index); }
+
+    void set(uint64_t index, GameResult result)
+    {
+        auto&      byte  = _bytes[index / 4];
+        const auto shift = 2 * (index % 4);
+        byte             = static_cast<uint8_t>((byte & ~(0b11u << shift)) | (static_cast<unsigned int>(result) << shift));
+    }
+
+    const std::vector<uint8_t>& bytes() const { return _bytes; }
+
+    static GameResult unpack(const uint8_t* bytes, uint64_t index)
+    {
+        return static_cast<GameResult>((bytes[index / 4] >> (2 * (index % 4))) & 0b11u);
+    }
+
+private:
+    std::vector<uint8_t> _bytes;
+};
+
+/// Computes the result of every position of `Game` by retrograde analysis:
+/// we start from the positions where the game is over, and walk the moves backwards.
+///  - A position from which we can move into a position that is lost for our opponent is won.
+///  - A position from which all the moves lead to positions that are won for our opponent is lost.
+///  - The positions that are never decided this way are draws.
+///
+/// `Game` must provide:
+///  - `static constexpr uint64_t positions_count`: the positions are indexed by all the integers in [0, positions_count)
+///  - `Game::Position` and `static std::optional<Position> decode(uint64_t index)`, which returns std::nullopt for the indices that are not valid positions
+///  - `static std::optional<GameResult> terminal_result(const Position&)`, which returns std::nullopt when the game is not over
+///  - `static int moves_count(const Position&)`
+///  - `static void for_each_predecessor(const Position&, uint64_t index, Callback&&)`, which calls `Callback` with the index of each position
+///     that leads to `Position` in one move. Only the indices of valid positions matter, the other ones are ignored
+template<typename Game>
+PackedGameResults compute_tablebase()
+{
+    auto results = PackedGameResults{Game::positions_count};
+    // How many moves of each position have not been proven to lose yet. 0 marks the positions that are not valid or already decided
+    auto moves_left = std::vector<uint8_t>(Game::positions_count, uint8_t{0});
+    auto decided    = std::vector<uint64_t>{}; // The positions that are won or lost, whose predecessors we still need to visit
+
+    for (uint64_t index = 0; index < Game::positions_count; ++index) {
+        const auto position = Game::decode(index);
+        if (!position.has_value()) {
+            continue;
+        }
+        const auto result = Game::terminal_result(*position);
+        if (result.has_value()) {
+            results.set(index, *result);
+            if (*result != GameResult::Draw) {
+                decided.push_back(index);
+            }
+        }
+        else {
+            moves_left[index] = static_cast<uint8_t>(Game::moves_count(*position));
+        }
+    }
+
+    for (size_t next = 0; next < decided.size(); ++next) {
+        const auto index    = decided[next];
+        const auto result   = results.get(index);
+        const auto position = Game::decode(index);
+        Game::for_each_predecessor(*position, index, [&](uint64_t predecessor) {
+            if (moves_left[predecessor] == 0) {
+                return;
+            }
+            if (result == GameResult::Loss) {
+                results.set(predecessor, GameResult::Win);
+                moves_left[predecessor] = 0;
+                decided.push_back(predecessor);
+            }
+            else if (--moves_left[predecessor] == 0) {
+                results.set(predecessor, GameResult::Loss);
+                decided.push_back(predecessor);
+            }
+        });
+    }
+
+    for (uint64_t index = 0; index < Game::positions_count; ++index) {
+        if (moves_left[index] != 0) {
+            results.set(index, GameResult::Draw);
+        }
+    }
+    return results;
+}
+
+/// Returns false iff the file could not be written
+bool save_tablebase(const PackedGameResults& results, uint64_t positions_count, const std::filesystem::path& path);
+
+/// A tablebase file, memory-mapped so that opening it is instantaneous, no matter its size
+class Tablebase {
+public:
+    /// Returns std::nullopt if the file doesn't exist or if it is not a tablebase with `positions_count` positions
+    static std::optional<Tablebase> open(const std::filesystem::path& path, uint64_t positions_count);
+
+    GameResult result(uint64_t position_index) const;
+
+private:
+    explicit Tablebase(MemoryMappedFile file)
+        : _file{std::move(file)}
+    {
+    }
+
+private:
+    MemoryMappedFile _file;
+};
+
+/// Prints how many positions are won, lost and drawn
+void show_tablebase_statistics(const PackedGameResults& results, uint64_t positions_count);
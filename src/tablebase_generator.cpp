@@ -0,0 +1,56 @@
+#include "tablebase_generator.h"
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include "connect_4.h"
+#include "mnk_game.h"
+#include "noughts_and_crosses.h"
+#include "tablebase.h"
+
+struct TablebaseGame {
+    std::function<PackedGameResults()> compute;
+    uint64_t                           positions_count;
+    std::string_view                   default_file;
+};
+
+static const std::map<std::string_view, TablebaseGame> tablebase_games{
+    {"noughts-and-crosses", {&compute_tablebase<MnkGame<NoughtsAndCrossesRules>>, MnkGame<NoughtsAndCrossesRules>::positions_count, noughts_and_crosses_tablebase_file}},
+    {"misere-noughts-and-crosses", {&compute_tablebase<MnkGame<MisereNoughtsAndCrossesRules>>, MnkGame<MisereNoughtsAndCrossesRules>::positions_count, misere_noughts_and_crosses_tablebase_file}},
+    {"gravity-noughts-and-crosses", {&compute_tablebase<MnkGame<GravityNoughtsAndCrossesRules>>, MnkGame<GravityNoughtsAndCrossesRules>::positions_count, gravity_noughts_and_crosses_tablebase_file}},
+    {"connect-3", {&compute_tablebase<MnkGame<Connect3Rules>>, MnkGame<Connect3Rules>::positions_count, connect_3_tablebase_file}},
+};
+
+void show_the_list_of_tablebase_games(const std::map<std::string_view, TablebaseGame>& games)
+{
+    std::cout << "Usage: build-tablebase <game> [output file]\nGames:\n";
+    for (const auto& [name, game] : games) {
+        std::cout << "  " << name << " (" << game.positions_count << " positions, saved to \"" << game.default_file << "\" by default)\n";
+    }
+}
+
+int generate_tablebase(const std::vector<std::string_view>& arguments)
+{
+    const auto game = arguments.empty() ? tablebase_games.end()
+                                        : tablebase_games.find(arguments[0]);
+    if (game == tablebase_games.end()) {
+        show_the_list_of_tablebase_games(tablebase_games);
+        return 1;
+    }
+    const auto path = std::filesystem::path{arguments.size() > 1 ? arguments[1] : game->second.default_file};
+
+    const auto begin   = std::chrono::steady_clock::now();
+    const auto results = game->second.compute();
+    const auto end     = std::chrono::steady_clock::now();
+    std::cout << "Computed " << game->second.positions_count << " positions in "
+              << std::chrono::duration<double>{end - begin}.count() << "s\n";
+    show_tablebase_statistics(results, game->second.positions_count);
+
+    if (!save_tablebase(results, game->second.positions_count, path)) {
+        std::cout << "Could not write \"" << path.string() << "\"\n";
+        return 1;
+    }
+    std::cout << "Saved to \"" << path.string() << "\"\n";
+    return 0;
+}
@@ -0,0 +1,7 @@
+#pragma once
+#include <string_view>
+#include <vector>
+
+/// Computes the tablebase of the game named by the first argument, and saves it in the file given as second argument (optional)
+/// Returns the exit code of the program
+int generate_tablebase(const std::vector<std::string_view>& arguments);
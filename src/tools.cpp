@@ -0,0 +1,68 @@
+#include "tools.h"
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include "dawg.h"
+#include "game_coroutine.h"
+#include "hangman_decision_tree.h"
+#include "hangman_solver.h"
+#include "input_source.h"
+#include "mcts.h"
+#include "menu.h"
+#include "noughts_and_crosses.h"
+#include "pattern_index.h"
+#include "play_guess_the_number.h"
+#include "rand.h"
+#include "screen.h"
+#include "tablebase_generator.h"
+#include "word_stream.h"
+
+using Arguments = std::vector<std::string_view>;
+
+struct Tool {
+    std::string                          description;
+    std::function<int(const Arguments&)> run;
+};
+
+static const std::map<std::string_view, Tool> tools{
+    {"benchmark-noughts-and-crosses-rendering", {"Measures the CPU time per frame of the Noughts and Crosses rendering", [](const Arguments&) {
+         benchmark_noughts_and_crosses_rendering();
+         return 0;
+     }}},
+    {"benchmark-rand", {"Compares the speed of the random number generators, on one thread and on several threads", &benchmark_rand}},
+    {"benchmark-game-sessions", {"Plays many games as coroutines on one thread, and measures the sessions per second and the memory of a suspended session", &benchmark_game_sessions}},
+    {"benchmark-input", {"Compares the speed of reading the integers piped to the standard input with std::cin and with the input of the games", &benchmark_input}},
+    {"benchmark-screen", {"Compares the time it takes to show the screens of many hangman games with more or less writes", &benchmark_screen}},
+    {"hangman-solver", {"Lets the computer guess the words of a hangman dictionary, and measures its speed and its average number of misses", &benchmark_hangman_solver}},
+    {"benchmark-pattern-index", {"Compares the search of the words that match a hangman pattern with an index and with a linear scan", &benchmark_pattern_index}},
+    {"simulate-playouts", {"Plays random games of ultimate noughts and crosses on several threads, with results that don't depend on the number of threads", &simulate_random_playouts}},
+    {"simulate-guess-the-number", {"Lets a bot that bisects play many rounds of guess the number, with numbers of up to 128 bits, and shows how many guesses it needs", &simulate_guess_the_number}},
+    {"simulate-liar-guess-the-number", {"Lets a Bayesian solver play many rounds of guess the number against an oracle that lies, and shows how many guesses it needs", &simulate_liar_guess_the_number}},
+    {"simulate-hangman", {"Lets the computer play hangman for every word of a dictionary, on several threads, and shows how often it wins", &simulate_hangman}},
+    {"build-dawg", {"Compresses a dictionary into a directed acyclic word graph, that hangman can use directly with --dawg <file>", &build_dawg}},
+    {"build-hangman-tree", {"Computes the guesses of the hangman solver for every game it can play with a dictionary, and saves them in a file", &build_hangman_decision_tree}},
+    {"hangman-tree-bot", {"Lets a bot that follows a tree made by build-hangman-tree play hangman for every word of a dictionary", &play_hangman_with_decision_tree}},
+    {"pick-random-word", {"Picks a random word in a file of any size without loading it, with the filter given with --word-length and --difficulty", &pick_a_random_word_tool}},
+    {"run-script", {"Plays the sessions of a script or of a session log (one input per line) without waiting for the user, and measures their speed", &run_script}},
+    {"build-tablebase", {"Computes the result of every position of a game by retrograde analysis, and saves them in a file", &generate_tablebase}},
+};
+
+void show_the_list_of_tools(const std::map<std::string_view, Tool>& tools)
+{
+    std::cout << "Available tools:\n";
+    for (const auto& [name, tool] : tools) {
+        std::cout << "  " << name << ": " << tool.description << '\n';
+    }
+}
+
+int run_tool(const Arguments& arguments)
+{
+    const auto tool = tools.find(arguments.front());
+    if (tool == tools.end()) {
+        std::cout << "Sorry I don't know the tool \"" << arguments.front() << "\"!\n";
+        show_the_list_of_tools(tools);
+        return 1;
+    }
+    return tool->second.run(Arguments{arguments.begin() + 1, arguments.end()});
+}
@@ -0,0 +1,8 @@
+#pragma once
+#include <string_view>
+#include <vector>
+
+/// Runs the tool (benchmark, generator, etc.) whose name is the first argument,
+/// and gives it the remaining arguments
+/// Returns the exit code of the program
+int run_tool(const std::vector<std::string_view>& arguments);
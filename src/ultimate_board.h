@@ -0,0 +1,130 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <optional>
+
+/// Ultimate noughts and crosses is played on a 3x3 grid of noughts and crosses boards (the "sub-boards").
+/// A move is a number between 0 and 80: `sub_board * 9 + cell`, where both `sub_board` and `cell` are numbered like this:
+///     6 7 8
+///     3 4 5
+///     0 1 2
+/// The cell you play in tells your opponent in which sub-board they have to play next.
+
+enum class UltimatePlayer : uint8_t {
+    Crosses,
+    Noughts,
+};
+
+inline UltimatePlayer other_player(UltimatePlayer player)
+{
+    return player == UltimatePlayer::Crosses ? UltimatePlayer::Noughts
+                                             : UltimatePlayer::Crosses;
+}
+
+/// Each sub-board is stored as one 9-bit mask per player, so that the 81 cells of a player fit in 9 `uint16_t`.
+/// This makes everything the AI needs (legal moves, wins, random playouts) a handful of bit operations.
+struct UltimateBoard {
+    std::array<std::array<uint16_t, 9>, 2> cells{};              // Indexed by [player][sub_board]
+    std::array<uint16_t, 2>                sub_boards_won{};     // Indexed by [player], one bit per sub-board
+    uint16_t                               sub_boards_closed{};  // A sub-board is closed once it is won or full
+    int                                    forced_sub_board{-1}; // -1 means that we can play in any sub-board that is not closed
+    UltimatePlayer                         current_player{UltimatePlayer::Crosses};
+};
+
+static constexpr uint16_t all_nine_bits = 0b111'111'111;
+
+/// `is_line[mask]` tells whether the 9-bit `mask` contains a row, a column or a diagonal
+inline constexpr std::array<bool, 512> is_line = [] {
+    constexpr std::array<uint16_t, 8> lines = {
+        0b000'000'111, 0b000'111'000, 0b111'000'000, // Rows
+        0b001'001'001, 0b010'010'010, 0b100'100'100, // Columns
+        0b100'010'001, 0b001'010'100,                // Diagonals
+    };
+    auto table = std::array<bool, 512>{};
+    for (size_t mask = 0; mask < table.size(); ++mask) {
+        for (const auto line : lines) {
+            if ((mask & line) == line) {
+                table[mask] = true;
+            }
+        }
+    }
+    return table;
+}();
+
+inline size_t index_of(UltimatePlayer player)
+{
+    return static_cast<size_t>(player);
+}
+
+/// Returns the mask of the cells that can be played in `sub_board` (which is empty if the sub-board is closed)
+inline uint16_t empty_cells(const UltimateBoard& board, int sub_board)
+{
+    if (board.sub_boards_closed & (1u << sub_board)) {
+        return 0;
+    }
+    return static_cast<uint16_t>(all_nine_bits & ~(board.cells[0][sub_board] | board.cells[1][sub_board]));
+}
+
+inline bool is_legal(const UltimateBoard& board, int move)
+{
+    const int sub_board = move / 9;
+    if (board.forced_sub_board != -1 && board.forced_sub_board != sub_board) {
+        return false;
+    }
+    return empty_cells(board, sub_board) & (1u << (move % 9));
+}
+
+/// Assumes that `move` is legal
+inline void play(UltimateBoard& board, int move)
+{
+    const int  sub_board = move / 9;
+    const int  cell      = move % 9;
+    const auto player    = index_of(board.current_player);
+    auto&      mine      = board.cells[player][sub_board];
+    mine                 = static_cast<uint16_t>(mine | (1u << cell));
+    if (is_line[mine]) {
+        board.sub_boards_won[player] = static_cast<uint16_t>(board.sub_boards_won[player] | (1u << sub_board));
+        board.sub_boards_closed      = static_cast<uint16_t>(board.sub_boards_closed | (1u << sub_board));
+    }
+    else if ((mine | board.cells[1 - player][sub_board]) == all_nine_bits) {
+        board.sub_boards_closed = static_cast<uint16_t>(board.sub_boards_closed | (1u << sub_board));
+    }
+    board.forced_sub_board = (board.sub_boards_closed & (1u << cell)) ? -1 : cell;
+    board.current_player   = other_player(board.current_player);
+}
+
+inline std::optional<UltimatePlayer> winner(const UltimateBoard& board)
+{
+    if (is_line[board.sub_boards_won[index_of(UltimatePlayer::Crosses)]]) {
+        return UltimatePlayer::Crosses;
+    }
+    if (is_line[board.sub_boards_won[index_of(UltimatePlayer::Noughts)]]) {
+        return UltimatePlayer::Noughts;
+    }
+    return std::nullopt;
+}
+
+/// A sub-board that is won by nobody is a draw, and when all sub-boards are closed without a winner the whole game is a draw
+inline bool game_is_over(const UltimateBoard& board)
+{
+    return board.sub_boards_closed == all_nine_bits || winner(board).has_value();
+}
+
+/// Writes all the legal moves into `moves` and returns how many there are
+inline int legal_moves(const UltimateBoard& board, std::array<uint8_t, 81>& moves)
+{
+    int count = 0;
+    for (int sub_board = 0; sub_board < 9; ++sub_board) {
+        if (board.forced_sub_board != -1 && board.forced_sub_board != sub_board) {
+            continue;
+        }
+        for (uint16_t empty = empty_cells(board, sub_board); empty != 0; empty &= empty - 1) {
+            int cell = 0;
+            while (!(empty & (1u << cell))) {
+                cell++;
+            }
+            moves[static_cast<size_t>(count++)] = static_cast<uint8_t>(sub_board * 9 + cell);
+        }
+    }
+    return count;
+}
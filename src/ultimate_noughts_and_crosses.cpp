@@ -0,0 +1,183 @@
+#include "ultimate_noughts_and_crosses.h"
+#include <p6/p6.h>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include "board.h"
+#include "get_input_from_user.h"
+#include "mcts.h"
+#include "noughts_and_crosses.h"
+#include "session.h"
+#include "ultimate_board.h"
+
+using Board = BoardT<9, 9, UltimatePlayer>;
+
+CellIndex cell_index_of(int move)
+{
+    const int sub_board = move / 9;
+    const int cell      = move % 9;
+    return {(sub_board % 3) * 3 + cell % 3,
+            (sub_board / 3) * 3 + cell / 3};
+}
+
+int move_at(CellIndex index)
+{
+    const int sub_board = (index.x / 3) + (index.y / 3) * 3;
+    const int cell      = (index.x % 3) + (index.y % 3) * 3;
+    return sub_board * 9 + cell;
+}
+
+Board to_board(const UltimateBoard& ultimate_board)
+{
+    auto board = Board{};
+    for (int move = 0; move < 81; ++move) {
+        const auto bit = 1u << (move % 9);
+        if (ultimate_board.cells[index_of(UltimatePlayer::Crosses)][static_cast<size_t>(move / 9)] & bit) {
+            board[cell_index_of(move)] = UltimatePlayer::Crosses;
+        }
+        else if (ultimate_board.cells[index_of(UltimatePlayer::Noughts)][static_cast<size_t>(move / 9)] & bit) {
+            board[cell_index_of(move)] = UltimatePlayer::Noughts;
+        }
+    }
+    return board;
+}
+
+void draw_ultimate_player(UltimatePlayer player, CellIndex index, int board_size, p6::Context& ctx)
+{
+    if (player == UltimatePlayer::Noughts) {
+        draw_nought(index, board_size, ctx);
+    }
+    else {
+        draw_cross(index, board_size, ctx);
+    }
+}
+
+void draw_playable_cells(const UltimateBoard& ultimate_board, p6::Context& ctx)
+{
+    ctx.stroke = {0.f, 0.f, 0.f, 0.f};
+    ctx.fill   = {1.f, 1.f, 1.f, 0.1f};
+    for (int move = 0; move < 81; ++move) {
+        if (is_legal(ultimate_board, move)) {
+            draw_cell(cell_index_of(move), 9, ctx);
+        }
+    }
+}
+
+void draw_sub_boards_winners(const UltimateBoard& ultimate_board, p6::Context& ctx)
+{
+    for (int sub_board = 0; sub_board < 9; ++sub_board) {
+        const auto index = CellIndex{sub_board % 3, sub_board / 3};
+        for (const auto player : {UltimatePlayer::Crosses, UltimatePlayer::Noughts}) {
+            if (ultimate_board.sub_boards_won[index_of(player)] & (1u << sub_board)) {
+                draw_ultimate_player(player, index, 3, ctx);
+            }
+        }
+    }
+}
+
+void draw_ultimate_noughts_and_crosses(const UltimateBoard& ultimate_board, p6::Context& ctx)
+{
+    ctx.background({.3f, 0.25f, 0.35f});
+    draw_playable_cells(ultimate_board, ctx);
+    ctx.fill          = {0.f, 0.f, 0.f, 0.f};
+    ctx.stroke        = {1.f, 1.f, 1.f, 0.5f};
+    ctx.stroke_weight = 0.005f;
+    draw_board(9, ctx);
+    ctx.stroke        = {1.f, 1.f, 1.f, 1.f};
+    ctx.stroke_weight = 0.02f;
+    draw_board(3, ctx);
+    const auto board = to_board(ultimate_board);
+    for (int x = 0; x < board.width(); ++x) {
+        for (int y = 0; y < board.height(); ++y) {
+            const auto& cell = board[{x, y}];
+            if (cell.has_value()) {
+                draw_ultimate_player(*cell, {x, y}, board.height(), ctx);
+            }
+        }
+    }
+    draw_sub_boards_winners(ultimate_board, ctx);
+}
+
+void try_draw_ultimate_player_on_hovered_cell(const UltimateBoard& ultimate_board, p6::Context& ctx)
+{
+    const auto hovered_cell = cell_hovered_by(ctx.mouse(), 9);
+    if (hovered_cell.has_value() && is_legal(ultimate_board, move_at(*hovered_cell))) {
+        draw_ultimate_player(ultimate_board.current_player, *hovered_cell, 9, ctx);
+    }
+}
+
+bool ultimate_game_is_finished(const UltimateBoard& ultimate_board)
+{
+    if (const auto winner_player = winner(ultimate_board); winner_player.has_value()) {
+        if (*winner_player == UltimatePlayer::Noughts) {
+            std::cout << "Noughts have won!\n";
+        }
+        else {
+            std::cout << "Crosses have won!\n";
+        }
+        return true;
+    }
+    else if (game_is_over(ultimate_board)) {
+        std::cout << "This is a draw!\n";
+        return true;
+    }
+    else {
+        return false;
+    }
+}
+
+std::chrono::milliseconds ask_for_thinking_budget()
+{
+    std::cout << "How many milliseconds can the computer think before each move?\n";
+    while (true) {
+        const int budget = get_input_from_user<int>();
+        if (budget > 0) {
+            return std::chrono::milliseconds{budget};
+        }
+        std::cout << "The computer needs at least 1 millisecond to think, please enter a positive number\n";
+    }
+}
+
+void play_ultimate_noughts_and_crosses()
+{
+    const auto thinking_budget = ask_for_thinking_budget();
+    auto       board           = UltimateBoard{};
+    auto       computer_move   = std::future<MctsResult>{};
+    auto       ctx             = p6::Context{{800, 800, "Ultimate Noughts and Crosses"}};
+
+    const auto is_computer_turn = [&]() {
+        return board.current_player == UltimatePlayer::Noughts;
+    };
+    ctx.mouse_pressed = [&](p6::MouseButton event) {
+        const auto cell = cell_hovered_by(event.position, 9);
+        if (!is_computer_turn() && cell.has_value() && is_legal(board, move_at(*cell))) {
+            log_move(move_at(*cell));
+            play(board, move_at(*cell));
+        }
+    };
+    ctx.update = [&]() {
+        draw_ultimate_noughts_and_crosses(board, ctx);
+        if (ultimate_game_is_finished(board)) {
+            ctx.stop();
+            return;
+        }
+        if (!is_computer_turn()) {
+            if (const auto move = replayed_move(); move.has_value() && 0 <= *move && *move < 81 && is_legal(board, *move)) {
+                log_move(*move);
+                play(board, *move);
+                return;
+            }
+            try_draw_ultimate_player_on_hovered_cell(board, ctx);
+        }
+        else if (!computer_move.valid()) { // The computer thinks on another thread so that the window stays responsive
+            computer_move = std::async(std::launch::async, &mcts_best_move, board, thinking_budget, replayed_ai_work());
+        }
+        else if (computer_move.wait_for(std::chrono::seconds{0}) == std::future_status::ready) {
+            const auto result = computer_move.get();
+            log_ai_work(result.playouts);
+            std::cout << "The computer simulated " << result.playouts << " games before playing\n";
+            play(board, result.move);
+        }
+    };
+    ctx.start();
+}
@@ -0,0 +1,7 @@
+#pragma once
+#include <chrono>
+
+void play_ultimate_noughts_and_crosses();
+
+/// Asks the user how long the computer can think before each of its moves, until they give a positive number of milliseconds
+std::chrono::milliseconds ask_for_thinking_budget();
\ No newline at end of file
@@ -0,0 +1,172 @@
+#include "word_stream.h"
+#include <algorithm>
+#include <bitset>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include "options.h"
+#include "rand.h"
+#include "word_with_missing_letters.h"
+
+WordDifficulty difficulty_of(std::string_view word)
+{
+    const auto different_letters_count = std::bitset<26>{letters_of(word)}.count();
+    if (different_letters_count >= 8) {
+        return WordDifficulty::Easy;
+    }
+    if (different_letters_count >= 5) {
+        return WordDifficulty::Medium;
+    }
+    return WordDifficulty::Hard;
+}
+
+bool WordFilter::accepts(std::string_view word) const
+{
+    // The longer words can't be played (and the lines that were cut because they were too long must not be taken for words), whatever the filter says
+    return min_length <= word.size() && word.size() <= std::min(max_length, Dictionary::max_word_length)
+           && (!difficulty.has_value() || difficulty_of(word) == *difficulty);
+}
+
+WordFilter word_filter_from_options()
+{
+    auto filter = WordFilter{};
+    if (const auto length = option("word-length"); length.has_value()) {
+        size_t     value  = 0;
+        const auto result = std::from_chars(length->data(), length->data() + length->size(), value);
+        if (result.ec == std::errc{} && result.ptr == length->data() + length->size() && value != 0 && value <= Dictionary::max_word_length) {
+            filter.min_length = value;
+            filter.max_length = value;
+        }
+        else {
+            std::cout << "The word length must be a number between 1 and " << Dictionary::max_word_length << ", ignoring \"" << *length << "\"\n";
+        }
+    }
+    if (const auto difficulty = option("difficulty"); difficulty.has_value()) {
+        if (*difficulty == "easy") {
+            filter.difficulty = WordDifficulty::Easy;
+        }
+        else if (*difficulty == "medium") {
+            filter.difficulty = WordDifficulty::Medium;
+        }
+        else if (*difficulty == "hard") {
+            filter.difficulty = WordDifficulty::Hard;
+        }
+        else {
+            std::cout << "The difficulty must be easy, medium or hard, ignoring \"" << *difficulty << "\"\n";
+        }
+    }
+    return filter;
+}
+
+/// Picks one of the words that it is given, without knowing how many there will be (reservoir sampling with a reservoir of one word)
+/// The n-th word replaces the picked one with a probability of 1/n, which leaves each word with a probability of 1/N at the end.
+/// Instead of drawing a random number for each word, we draw the index of the next word that will replace the picked one:
+/// it is greater than m with a probability of n/m, so we only need a random number each time the picked word changes, i.e. about log(N) times.
+class WordReservoir {
+public:
+    void add(std::string_view word)
+    {
+        _words_count++;
+        if (_words_count == _next_pick) {
+            _picked_word = word;
+            _next_pick   = next_pick_after(_words_count);
+        }
+    }
+
+    std::optional<std::string> picked_word() const
+    {
+        if (_words_count == 0) {
+            return std::nullopt;
+        }
+        return _picked_word;
+    }
+
+private:
+    static uint64_t next_pick_after(uint64_t index)
+    {
+        const auto random = 1. - rand(0., 1.); // Between 0 (excluded) and 1 (included)
+        const auto next   = static_cast<double>(index) / random + 1.;
+        if (next >= static_cast<double>(std::numeric_limits<uint64_t>::max())) {
+            return std::numeric_limits<uint64_t>::max();
+        }
+        return static_cast<uint64_t>(next);
+    }
+
+private:
+    std::string _picked_word;
+    uint64_t    _words_count{0};
+    uint64_t    _next_pick{1};
+};
+
+std::optional<std::string> pick_a_random_word_in_file(const std::filesystem::path& path, const WordFilter& filter)
+{
+    static constexpr size_t chunk_size = 1 << 20;
+
+    auto file = std::ifstream{path, std::ios::binary};
+    if (!file) {
+        return std::nullopt;
+    }
+    auto       reservoir = WordReservoir{};
+    const auto add_line  = [&](std::string_view word) {
+        if (!word.empty() && word.back() == '\r') { // Files written on Windows
+            word.remove_suffix(1);
+        }
+        if (!word.empty() && is_made_of_lowercase_letters(word) && filter.accepts(word)) {
+            reservoir.add(word);
+        }
+    };
+    // The lines that are cut by the end of a chunk are finished in `cut_line`.
+    // It only keeps what is needed to know that a line is too long to be a word, even with a '\r', so that its size stays bounded.
+    static constexpr size_t max_cut_line_size = Dictionary::max_word_length + 2;
+
+    auto       cut_line        = std::string{};
+    const auto append_cut_line = [&](std::string_view part) {
+        cut_line.append(part.substr(0, max_cut_line_size - std::min(cut_line.size(), max_cut_line_size)));
+    };
+    auto chunk = std::vector<char>(chunk_size);
+    while (file) {
+        file.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        const char*       line_begin = chunk.data();
+        const char* const chunk_end  = chunk.data() + file.gcount();
+        while (const auto* line_end = static_cast<const char*>(std::memchr(line_begin, '\n', static_cast<size_t>(chunk_end - line_begin)))) {
+            const auto line = std::string_view{line_begin, static_cast<size_t>(line_end - line_begin)};
+            if (cut_line.empty()) {
+                add_line(line);
+            }
+            else {
+                append_cut_line(line);
+                add_line(cut_line);
+                cut_line.clear();
+            }
+            line_begin = line_end + 1;
+        }
+        append_cut_line({line_begin, static_cast<size_t>(chunk_end - line_begin)});
+    }
+    add_line(cut_line);
+    return reservoir.picked_word();
+}
+
+int pick_a_random_word_tool(const std::vector<std::string_view>& arguments)
+{
+    if (arguments.empty()) {
+        std::cout << "Usage: pick-random-word <file> [--word-length <n>] [--difficulty <easy|medium|hard>]\n";
+        return 1;
+    }
+    const auto path   = std::filesystem::path{arguments[0]};
+    const auto filter = word_filter_from_options();
+    const auto begin  = std::chrono::steady_clock::now();
+    const auto word   = pick_a_random_word_in_file(path, filter);
+    const auto end    = std::chrono::steady_clock::now();
+    if (!word.has_value()) {
+        std::cout << "Could not find any word that matches the filter in \"" << path.string() << "\"\n";
+        return 1;
+    }
+    const auto seconds = std::chrono::duration<double>{end - begin}.count();
+    std::cout << *word << '\n'
+              << "Read " << std::filesystem::file_size(path) << " bytes in " << seconds << "s ("
+              << static_cast<double>(std::filesystem::file_size(path)) / seconds / 1e6 << " MB/s)\n";
+    return 0;
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "dictionary.h"
+
+/// How hard a word is to guess in hangman
+/// The words with few different letters are the hardest, because most guesses are misses (think of "jazz" or "fuzz").
+enum class WordDifficulty {
+    Easy,   // 8 different letters or more
+    Medium, // 5 to 7 different letters
+    Hard,   // 4 different letters or less
+};
+
+WordDifficulty difficulty_of(std::string_view word);
+
+/// The words that can be picked
+struct WordFilter {
+    size_t                        min_length{1};
+    size_t                        max_length{Dictionary::max_word_length};
+    std::optional<WordDifficulty> difficulty; // All the difficulties if std::nullopt
+
+    /// Returns true iff `word` has the right length and difficulty. It must be made of lowercase letters.
+    /// The words longer than Dictionary::max_word_length are never accepted, since the games can't play them.
+    bool accepts(std::string_view word) const;
+};
+
+/// Reads the filter from the command line: `--word-length <n>` and `--difficulty <easy|medium|hard>`
+/// Shows a message and ignores the options that have an invalid value.
+WordFilter word_filter_from_options();
+
+/// Picks a random word in the file at `path`, which contains one word per line, without loading it:
+/// the file is read once, by chunks, and only the picked word is kept in memory, so it can be as big as needed.
+/// All the words accepted by `filter` have the same probability to be picked (like in Dictionary, only the words made of lowercase letters count).
+/// Returns std::nullopt if the file can't be read or if no word is accepted by `filter`.
+std::optional<std::string> pick_a_random_word_in_file(const std::filesystem::path& path, const WordFilter& filter);
+
+/// Picks a random word in the file given in `arguments`, with the filter given with `--word-length` and `--difficulty`, and shows how long it took
+int pick_a_random_word_tool(const std::vector<std::string_view>& arguments);
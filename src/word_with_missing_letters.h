@@ -0,0 +1,91 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+/// A set of letters from 'a' to 'z', one bit per letter
+using LetterMask = uint32_t;
+
+inline bool is_lowercase_letter(char letter)
+{
+    return 'a' <= letter && letter <= 'z';
+}
+
+/// `letter` must be a letter from 'a' to 'z'
+inline LetterMask letter_bit(char letter)
+{
+    return LetterMask{1} << (letter - 'a');
+}
+
+/// The set of the letters that appear in `word`, which must only be made of letters from 'a' to 'z'
+inline LetterMask letters_of(std::string_view word)
+{
+    LetterMask letters = 0;
+    for (const char letter : word) {
+        letters |= letter_bit(letter);
+    }
+    return letters;
+}
+
+/// The positions of `letter` in `word`, one bit per position. Only the first 64 letters of `word` are looked at.
+/// Compares 8 letters at a time, since it is the inner loop of the solvers (it assumes a little-endian CPU, like all the ones we run on).
+inline uint64_t positions_of(char letter, std::string_view word)
+{
+    static constexpr uint64_t low_bits  = 0x7F7F7F7F7F7F7F7F;
+    const uint64_t            letters   = 0x0101010101010101 * static_cast<unsigned char>(letter);
+    const auto                length    = std::min(word.size(), size_t{64});
+    uint64_t                  positions = 0;
+    for (size_t i = 0; i < length; i += 8) {
+        uint64_t chunk = 0; // The bytes after the end of the word stay 0, which is never a letter
+        std::memcpy(&chunk, word.data() + i, std::min(size_t{8}, length - i));
+        const auto differences = chunk ^ letters;
+        const auto equal_bytes = ~(((differences & low_bits) + low_bits) | differences | low_bits); // 0x80 in the bytes that are 0 in `differences`
+        positions |= (((equal_bytes >> 7) * 0x0102040810204080) >> 56) << i;                      // Gathers the bit of each byte in the highest byte
+    }
+    return positions;
+}
+
+/// A word whose letters are revealed as they get guessed
+/// The state of the word is a few bit masks, so that a guess, a reveal and the check that the whole word has been found
+/// are each a few bit operations, no matter the length of the word.
+class WordWithMissingLetters {
+public:
+    /// `word` must only be made of letters from 'a' to 'z', and have at most 64 of them
+    WordWithMissingLetters(std::string_view word)
+        : _word{word}
+        , _letters{letters_of(word)}
+        , _all_positions{word.size() == 64 ? ~uint64_t{0} : (uint64_t{1} << word.size()) - 1}
+    {
+        assert(word.size() <= 64);
+        for (size_t i = 0; i < word.size(); ++i) {
+            _positions[static_cast<size_t>(word[i] - 'a')] |= uint64_t{1} << i;
+        }
+    }
+
+    void mark_as_guessed(char guessed_letter) // mark_as_guessed is the only function in our hangman program that needs mutable access to the private variables
+    {
+        _revealed |= positions_of(guessed_letter);
+    }
+
+    bool contains(char letter) const { return is_lowercase_letter(letter) && (_letters & letter_bit(letter)); }
+
+    /// The positions of `letter` in the word, one bit per position
+    uint64_t positions_of(char letter) const { return is_lowercase_letter(letter) ? _positions[static_cast<size_t>(letter - 'a')] : 0; }
+
+    // We add getters but no setters: people can see the values but not modify them
+    // because we don't want anybody to be able to mess up our invariant
+    const std::string& word() const { return _word; }
+    bool               is_revealed(size_t position) const { return _revealed & (uint64_t{1} << position); }
+    bool               is_fully_revealed() const { return _revealed == _all_positions; }
+
+private:
+    std::string              _word;
+    LetterMask               _letters;
+    std::array<uint64_t, 26> _positions{}; // The positions of each letter, one bit per position
+    uint64_t                 _revealed{0}; // The positions of the letters that have been guessed
+    uint64_t                 _all_positions;
+};